@@ -0,0 +1,279 @@
+/**
+ * @file AnimBench.cpp
+ *
+ * @author Aditya Menon
+ *
+ * Benchmarks for the animation core on large synthetic scenes
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include <Picture.h>
+#include <Actor.h>
+#include <Drawable.h>
+#include <Timeline.h>
+
+/// Drawables in each synthetic actor
+const int DrawablesPerActor = 5;
+
+/// Frames between keyframes
+const int KeyframeSpacing = 3;
+
+/**
+ * A drawable that draws nothing, so Actor::Draw measures
+ * only the placement of the hierarchy
+ */
+class BenchDrawable : public Drawable
+{
+public:
+    /**
+     * Constructor
+     * @param name Drawable name
+     */
+    BenchDrawable(const std::wstring& name) : Drawable(name) {}
+
+    /**
+     * Draw nothing
+     * @param graphics Graphics context, unused
+     */
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override {}
+
+    /**
+     * Never hit
+     * @param pos Position to test
+     * @return false
+     */
+    bool HitTest(wxPoint pos) override { return false; }
+};
+
+/**
+ * A synthetic scene and the arguments it was built for
+ */
+struct Scene
+{
+    /// Number of actors
+    int mActors = 0;
+
+    /// Keyframes in each channel
+    int mKeyframes = 0;
+
+    /// Number of channels in the timeline
+    int mChannels = 0;
+
+    /// The picture holding the actors
+    std::shared_ptr<Picture> mPicture;
+};
+
+/**
+ * Create one actor with a small drawable hierarchy: a body
+ * with a head and two arms, one of which holds a hand
+ * @param name Actor name
+ * @param drawables Collection the new drawables are added to
+ * @return New actor
+ */
+static std::shared_ptr<Actor> CreateActor(const std::wstring& name, std::vector<std::shared_ptr<Drawable>>& drawables)
+{
+    auto actor = std::make_shared<Actor>(name);
+
+    auto body = std::make_shared<BenchDrawable>(L"Body");
+    auto head = std::make_shared<BenchDrawable>(L"Head");
+    auto leftArm = std::make_shared<BenchDrawable>(L"Left Arm");
+    auto rightArm = std::make_shared<BenchDrawable>(L"Right Arm");
+    auto hand = std::make_shared<BenchDrawable>(L"Hand");
+
+    head->SetPosition(wxPoint(0, -50));
+    leftArm->SetPosition(wxPoint(-20, -40));
+    rightArm->SetPosition(wxPoint(20, -40));
+    hand->SetPosition(wxPoint(0, 30));
+
+    body->AddChild(head);
+    body->AddChild(leftArm);
+    body->AddChild(rightArm);
+    leftArm->AddChild(hand);
+
+    actor->SetRoot(body);
+    for (std::shared_ptr<Drawable> drawable : {body, head, leftArm, rightArm, hand})
+    {
+        actor->AddDrawable(drawable);
+        drawables.push_back(drawable);
+    }
+
+    return actor;
+}
+
+/**
+ * Get a synthetic scene, building it if it is not the last one built
+ *
+ * Every actor gets a keyframe for its position and every
+ * drawable rotation each KeyframeSpacing frames, so every
+ * channel has the same number of keyframes.
+ * @param actors Number of actors
+ * @param keyframes Keyframes in each channel
+ * @return The scene
+ */
+static const Scene& GetScene(int actors, int keyframes)
+{
+    // Only the most recent scene is kept, the large ones take a lot of memory
+    static Scene scene;
+    if (scene.mActors == actors && scene.mKeyframes == keyframes)
+    {
+        return scene;
+    }
+
+    scene = Scene();
+    scene.mActors = actors;
+    scene.mKeyframes = keyframes;
+    scene.mPicture = std::make_shared<Picture>();
+
+    auto timeline = scene.mPicture->GetTimeline();
+    timeline->SetNumFrames(keyframes * KeyframeSpacing);
+
+    std::vector<std::shared_ptr<Actor>> allActors;
+    std::vector<std::shared_ptr<Drawable>> allDrawables;
+    for (int a = 0; a < actors; a++)
+    {
+        auto actor = CreateActor(L"Actor " + std::to_wstring(a), allDrawables);
+        actor->SetPosition(wxPoint(a % 100 * 20, a / 100 * 20));
+        scene.mPicture->AddActor(actor);
+        allActors.push_back(actor);
+    }
+
+    scene.mChannels = actors * (DrawablesPerActor + 1);
+
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> step(-3, 3);
+    std::uniform_real_distribution<double> angle(-0.5, 0.5);
+
+    for (int k = 0; k < keyframes; k++)
+    {
+        timeline->SetCurrentTime(double(k * KeyframeSpacing) / timeline->GetFrameRate());
+
+        for (auto& drawable : allDrawables)
+        {
+            drawable->SetRotation(angle(random));
+        }
+
+        for (auto& actor : allActors)
+        {
+            actor->SetPosition(actor->GetPosition() + wxPoint(step(random), step(random)));
+            actor->SetKeyframe();
+        }
+    }
+
+    timeline->SetCurrentTime(0);
+    return scene;
+}
+
+/**
+ * The scene sizes measured. Each has about the same total number
+ * of keyframes, trading actor count against keyframe density.
+ * @param benchmark Benchmark to add the arguments to
+ */
+static void SceneArgs(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"actors", "keyframes"});
+    benchmark->Args({10, 20000});
+    benchmark->Args({100, 2000});
+    benchmark->Args({1000, 200});
+    benchmark->Args({4000, 50});
+}
+
+/**
+ * Play the timeline forward one frame at a time
+ * @param state Benchmark state, range(0) actors, range(1) keyframes per channel
+ */
+static void TimelineSequential(benchmark::State& state)
+{
+    auto& scene = GetScene(int(state.range(0)), int(state.range(1)));
+    auto timeline = scene.mPicture->GetTimeline();
+    double frameRate = timeline->GetFrameRate();
+    int numFrames = timeline->GetNumFrames();
+
+    int frame = 0;
+    for (auto _ : state)
+    {
+        timeline->SetCurrentTime(frame / frameRate);
+        frame = (frame + 1) % numFrames;
+    }
+
+    state.SetItemsProcessed(state.iterations() * scene.mChannels);
+}
+BENCHMARK(TimelineSequential)->Apply(SceneArgs);
+
+/**
+ * Seek the timeline to random frames
+ * @param state Benchmark state, range(0) actors, range(1) keyframes per channel
+ */
+static void TimelineRandom(benchmark::State& state)
+{
+    auto& scene = GetScene(int(state.range(0)), int(state.range(1)));
+    auto timeline = scene.mPicture->GetTimeline();
+    double frameRate = timeline->GetFrameRate();
+
+    std::mt19937 random(2);
+    std::uniform_int_distribution<int> distribution(0, timeline->GetNumFrames() - 1);
+    std::vector<int> frames(1024);
+    for (auto& frame : frames)
+    {
+        frame = distribution(random);
+    }
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        timeline->SetCurrentTime(frames[i] / frameRate);
+        i = (i + 1) % frames.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * scene.mChannels);
+}
+BENCHMARK(TimelineRandom)->Apply(SceneArgs);
+
+/**
+ * Scrub the timeline backwards one frame at a time
+ * @param state Benchmark state, range(0) actors, range(1) keyframes per channel
+ */
+static void TimelineReverse(benchmark::State& state)
+{
+    auto& scene = GetScene(int(state.range(0)), int(state.range(1)));
+    auto timeline = scene.mPicture->GetTimeline();
+    double frameRate = timeline->GetFrameRate();
+    int numFrames = timeline->GetNumFrames();
+
+    int frame = numFrames - 1;
+    for (auto _ : state)
+    {
+        timeline->SetCurrentTime(frame / frameRate);
+        frame = frame > 0 ? frame - 1 : numFrames - 1;
+    }
+
+    state.SetItemsProcessed(state.iterations() * scene.mChannels);
+}
+BENCHMARK(TimelineReverse)->Apply(SceneArgs);
+
+/**
+ * Place every drawable of every actor
+ * @param state Benchmark state, range(0) actors, range(1) keyframes per channel
+ */
+static void ActorDrawPlacement(benchmark::State& state)
+{
+    auto& scene = GetScene(int(state.range(0)), int(state.range(1)));
+    auto picture = scene.mPicture;
+
+    // Somewhere in the middle of the animation, between keyframes
+    picture->SetAnimationTime(picture->GetTimeline()->GetDuration() / 2 + 1.0 / 60);
+
+    std::shared_ptr<wxGraphicsContext> graphics;
+    for (auto _ : state)
+    {
+        for (auto actor : *picture)
+        {
+            actor->Draw(graphics);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * scene.mActors * DrawablesPerActor);
+}
+BENCHMARK(ActorDrawPlacement)->Apply(SceneArgs);
@@ -6,6 +6,7 @@
 #include "pch.h"
 
 #include <sstream>
+#include <frame-profiler.h>
 
 #include "Actor.h"
 #include "Drawable.h"
@@ -44,7 +45,11 @@ void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     // of all of the child drawables. We have to determine this
     // in tree order, which may not be the order we draw.
     if (mRoot != nullptr)
+    {
+        // Timed here rather than in Drawable::Place, which recurses
+        FrameProfiler::Scope profile(FrameProfiler::Phase::Place);
         mRoot->Place(mPosition, 0);
+    }
 
     for (auto drawable : mDrawablesInOrder)
     {
@@ -131,6 +136,8 @@ void Actor::SetKeyframe()
  */
 void Actor::GetKeyframe()
 {
+    FrameProfiler::Scope profile(FrameProfiler::Phase::Keyframe);
+
     if (mChannel.IsValid())
     {
         mPosition = mChannel.GetPoint();
@@ -0,0 +1,193 @@
+/**
+ * @file AnimBinary.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <cstring>
+#include <fstream>
+#include "AnimBinary.h"
+
+/// The first eight bytes of every binary animation file
+static const char Magic[8] = {'C', 'E', 'A', 'N', 'I', 'M', 'B', '\0'};
+
+/**
+ * Get the eight bytes a binary animation file starts with
+ * @return Pointer to the eight bytes
+ */
+const char* AnimBinary::GetMagic()
+{
+    return Magic;
+}
+
+/**
+ * Determine if a file is a binary animation file rather than XML
+ * @param filename File to check
+ * @return true if the file starts with the binary animation magic
+ */
+bool AnimBinary::IsBinary(const std::wstring& filename)
+{
+    std::ifstream file(wxString(filename).fn_str(), std::ios::binary);
+    char magic[sizeof(Magic)];
+    if (!file.read(magic, sizeof(magic)))
+    {
+        return false;
+    }
+
+    return memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+/**
+ * Map a binary animation file and check that it is valid
+ * @param filename File to open
+ * @return true if the file was opened. If false, nothing else may be called.
+ */
+bool AnimBinary::Open(const std::wstring& filename)
+{
+    mHeader = nullptr;
+    if (!mFile.Open(filename) || !Validate())
+    {
+        mFile.Close();
+        mHeader = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Check that the mapped file is a binary animation this version
+ * can read and that every record lies within the file, and set
+ * the pointers to the header and tables.
+ * @return true if the file is valid
+ */
+bool AnimBinary::Validate()
+{
+    auto data = mFile.GetData();
+    uint64_t size = mFile.GetSize();
+
+    // Is a block of count items of itemSize bytes at offset
+    // within the file and aligned for the items?
+    auto within = [size](uint64_t offset, uint64_t count, uint64_t itemSize, uint64_t align) {
+        return offset % align == 0 && offset <= size && count <= (size - offset) / itemSize;
+    };
+
+    if (size < sizeof(Header))
+    {
+        return false;
+    }
+
+    auto header = reinterpret_cast<const Header*>(data);
+    if (memcmp(header->mMagic, Magic, sizeof(Magic)) != 0 ||
+        header->mVersion == 0 || header->mVersion > Version ||
+        header->mByteOrder != ByteOrderMark ||
+        header->mNumFrames < 0 || header->mFrameRate <= 0)
+    {
+        return false;
+    }
+
+    uint64_t channelsOffset = sizeof(Header);
+    uint64_t machinesOffset = channelsOffset + uint64_t(header->mNumChannels) * sizeof(ChannelRecord);
+    if (!within(channelsOffset, header->mNumChannels, sizeof(ChannelRecord), 8) ||
+        !within(machinesOffset, header->mNumMachines, sizeof(MachineRecord), 8) ||
+        !within(header->mNamesOffset, header->mNamesSize, 1, 1))
+    {
+        return false;
+    }
+
+    auto channels = reinterpret_cast<const ChannelRecord*>(data + channelsOffset);
+    auto machines = reinterpret_cast<const MachineRecord*>(data + machinesOffset);
+    auto namesSize = header->mNamesSize;
+    auto nameWithin = [namesSize](uint32_t offset, uint32_t length) {
+        return offset <= namesSize && length <= namesSize - offset;
+    };
+
+    for (uint32_t i = 0; i < header->mNumChannels; i++)
+    {
+        auto& channel = channels[i];
+        uint64_t valueSize = channel.mType == uint32_t(ChannelType::Angle) ? sizeof(double) : 2 * sizeof(int32_t);
+        if ((channel.mType != uint32_t(ChannelType::Angle) && channel.mType != uint32_t(ChannelType::Point)) ||
+            !nameWithin(channel.mNameOffset, channel.mNameLength) ||
+            !within(channel.mFramesOffset, channel.mNumKeyframes, sizeof(int32_t), 8) ||
+            !within(channel.mValuesOffset, channel.mNumKeyframes, valueSize, 8))
+        {
+            return false;
+        }
+
+        // The channels search the frames, so they must be in order
+        auto frames = reinterpret_cast<const int32_t*>(data + channel.mFramesOffset);
+        for (uint32_t k = 1; k < channel.mNumKeyframes; k++)
+        {
+            if (frames[k] <= frames[k - 1])
+            {
+                return false;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < header->mNumMachines; i++)
+    {
+        if (!nameWithin(machines[i].mNameOffset, machines[i].mNameLength))
+        {
+            return false;
+        }
+    }
+
+    mHeader = header;
+    mChannels = channels;
+    mMachines = machines;
+    mNames = data + header->mNamesOffset;
+    return true;
+}
+
+/**
+ * Get the name of a channel
+ * @param channel Channel index
+ * @return The channel name
+ */
+std::wstring AnimBinary::GetChannelName(int channel) const
+{
+    auto& record = mChannels[channel];
+    return wxString::FromUTF8(mNames + record.mNameOffset, record.mNameLength).ToStdWstring();
+}
+
+/**
+ * Get the frames of a channel's keyframes
+ * @param channel Channel index
+ * @return GetNumKeyframes frames in increasing order
+ */
+const int32_t* AnimBinary::GetFrames(int channel) const
+{
+    return reinterpret_cast<const int32_t*>(mFile.GetData() + mChannels[channel].mFramesOffset);
+}
+
+/**
+ * Get the angles of an angle channel's keyframes
+ * @param channel Channel index
+ * @return GetNumKeyframes angles in radians
+ */
+const double* AnimBinary::GetAngles(int channel) const
+{
+    return reinterpret_cast<const double*>(mFile.GetData() + mChannels[channel].mValuesOffset);
+}
+
+/**
+ * Get the points of a point channel's keyframes
+ * @param channel Channel index
+ * @return GetNumKeyframes x,y pairs
+ */
+const int32_t* AnimBinary::GetPoints(int channel) const
+{
+    return reinterpret_cast<const int32_t*>(mFile.GetData() + mChannels[channel].mValuesOffset);
+}
+
+/**
+ * Get the name of a machine
+ * @param machine Machine index
+ * @return The machine name
+ */
+std::wstring AnimBinary::GetMachineName(int machine) const
+{
+    auto& record = mMachines[machine];
+    return wxString::FromUTF8(mNames + record.mNameOffset, record.mNameLength).ToStdWstring();
+}
@@ -0,0 +1,175 @@
+/**
+ * @file AnimBinary.h
+ * @author Aditya Menon
+ *
+ * A binary animation file, mapped into memory
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMBINARY_H
+#define CANADIANEXPERIENCE_ANIMBINARY_H
+
+#include <cstdint>
+#include "MappedFile.h"
+
+/**
+ * A binary animation file, mapped into memory.
+ *
+ * This holds the same animation as the XML .anim format: the
+ * timeline settings, the keyframes of every channel and the
+ * machine settings. Values are stored exactly as they are held
+ * in memory, so nothing is parsed or rounded when loading, and
+ * the keyframe arrays are read directly from the mapped file.
+ *
+ * The layout, with every offset in bytes from the start
+ * of the file and every array aligned to 8 bytes:
+ *
+ *     Header
+ *     ChannelRecord[Header::mNumChannels]
+ *     MachineRecord[Header::mNumMachines]
+ *     Names, UTF-8 without terminators
+ *     For each channel: int32 frames[n], then
+ *         double angles[n] or int32 points[n][2]
+ *
+ * Frames are in increasing order. Files are written in the byte
+ * order of the machine that writes them; Open rejects a file with
+ * the other byte order, a newer version or any value out of range.
+ */
+class AnimBinary
+{
+public:
+    /// Current format version
+    static const uint32_t Version = 1;
+
+    /// The channel types
+    enum class ChannelType : uint32_t {
+        Angle = 0,  ///< An AnimChannelAngle, values are doubles
+        Point = 1   ///< An AnimChannelPoint, values are x,y int32 pairs
+    };
+
+    /// The file header
+    struct Header
+    {
+        char mMagic[8];             ///< Identifies the file, see IsBinary
+        uint32_t mVersion;          ///< Format version
+        uint32_t mByteOrder;        ///< ByteOrderMark as written
+        int32_t mNumFrames;         ///< Timeline number of frames
+        int32_t mFrameRate;         ///< Timeline frame rate
+        uint32_t mNumChannels;      ///< Number of channel records
+        uint32_t mNumMachines;      ///< Number of machine records
+        uint64_t mNamesOffset;      ///< Offset of the names
+        uint64_t mNamesSize;        ///< Size of the names in bytes
+    };
+
+    /// One channel
+    struct ChannelRecord
+    {
+        uint32_t mNameOffset;       ///< Offset of the name within the names
+        uint32_t mNameLength;       ///< Length of the name in bytes
+        uint32_t mType;             ///< A ChannelType
+        uint32_t mNumKeyframes;     ///< Number of keyframes
+        uint64_t mFramesOffset;     ///< Offset of the keyframe frames
+        uint64_t mValuesOffset;     ///< Offset of the keyframe values
+    };
+
+    /// One machine
+    struct MachineRecord
+    {
+        uint32_t mNameOffset;       ///< Offset of the name within the names
+        uint32_t mNameLength;       ///< Length of the name in bytes
+        int32_t mX;                 ///< Position X
+        int32_t mY;                 ///< Position Y
+        int32_t mMachineNumber;     ///< Machine number
+        int32_t mStartFrame;        ///< Frame the machine starts on
+        double mScale;              ///< Drawing scale
+    };
+
+    /// Written in Header::mByteOrder to detect the byte order
+    static const uint32_t ByteOrderMark = 0x01020304;
+
+private:
+    /// The mapped file
+    MappedFile mFile;
+
+    /// The header, in the mapped file
+    const Header* mHeader = nullptr;
+
+    /// The channel records, in the mapped file
+    const ChannelRecord* mChannels = nullptr;
+
+    /// The machine records, in the mapped file
+    const MachineRecord* mMachines = nullptr;
+
+    /// The names, in the mapped file
+    const char* mNames = nullptr;
+
+    bool Validate();
+
+public:
+    AnimBinary() {}
+
+    /// Copy constructor (disabled)
+    AnimBinary(const AnimBinary &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const AnimBinary &) = delete;
+
+    static bool IsBinary(const std::wstring& filename);
+    static const char* GetMagic();
+
+    bool Open(const std::wstring& filename);
+
+    /**
+     * Get the timeline number of frames
+     * @return Number of frames
+     */
+    int GetNumFrames() const { return mHeader->mNumFrames; }
+
+    /**
+     * Get the timeline frame rate
+     * @return Frames per second
+     */
+    int GetFrameRate() const { return mHeader->mFrameRate; }
+
+    /**
+     * Get the number of channels
+     * @return Number of channels
+     */
+    int GetNumChannels() const { return (int)mHeader->mNumChannels; }
+
+    std::wstring GetChannelName(int channel) const;
+
+    /**
+     * Get the type of a channel
+     * @param channel Channel index
+     * @return The channel type
+     */
+    ChannelType GetChannelType(int channel) const { return ChannelType(mChannels[channel].mType); }
+
+    /**
+     * Get the number of keyframes in a channel
+     * @param channel Channel index
+     * @return Number of keyframes
+     */
+    int GetNumKeyframes(int channel) const { return (int)mChannels[channel].mNumKeyframes; }
+
+    const int32_t* GetFrames(int channel) const;
+    const double* GetAngles(int channel) const;
+    const int32_t* GetPoints(int channel) const;
+
+    /**
+     * Get the number of machines
+     * @return Number of machines
+     */
+    int GetNumMachines() const { return (int)mHeader->mNumMachines; }
+
+    /**
+     * Get the settings of a machine
+     * @param machine Machine index
+     * @return The machine record
+     */
+    const MachineRecord& GetMachine(int machine) const { return mMachines[machine]; }
+
+    std::wstring GetMachineName(int machine) const;
+};
+
+#endif //CANADIANEXPERIENCE_ANIMBINARY_H
@@ -0,0 +1,188 @@
+/**
+ * @file AnimBinaryWriter.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <cstring>
+#include <fstream>
+#include "AnimBinaryWriter.h"
+
+/**
+ * Round an offset up to the 8 byte alignment of the arrays
+ * @param offset Offset in bytes
+ * @return The aligned offset
+ */
+static uint64_t Align(uint64_t offset)
+{
+    return (offset + 7) & ~uint64_t(7);
+}
+
+/**
+ * Convert a name to UTF-8
+ * @param name Name
+ * @return The UTF-8 bytes
+ */
+static std::string ToUTF8(const std::wstring& name)
+{
+    auto utf8 = wxString(name).ToUTF8();
+    return std::string(utf8.data(), utf8.length());
+}
+
+/**
+ * Add an angle channel
+ * @param name Channel name
+ * @param frames Keyframe frames in increasing order
+ * @param angles Keyframe angles in radians
+ */
+void AnimBinaryWriter::AddAngleChannel(const std::wstring& name, const std::vector<int>& frames, const std::vector<double>& angles)
+{
+    Channel channel;
+    channel.mName = ToUTF8(name);
+    channel.mType = AnimBinary::ChannelType::Angle;
+    channel.mFrames.assign(frames.begin(), frames.end());
+    channel.mAngles = angles;
+    mChannels.push_back(std::move(channel));
+}
+
+/**
+ * Add a point channel
+ * @param name Channel name
+ * @param frames Keyframe frames in increasing order
+ * @param points Keyframe points
+ */
+void AnimBinaryWriter::AddPointChannel(const std::wstring& name, const std::vector<int>& frames, const std::vector<wxPoint>& points)
+{
+    Channel channel;
+    channel.mName = ToUTF8(name);
+    channel.mType = AnimBinary::ChannelType::Point;
+    channel.mFrames.assign(frames.begin(), frames.end());
+    for (auto point : points)
+    {
+        channel.mPoints.push_back(point.x);
+        channel.mPoints.push_back(point.y);
+    }
+    mChannels.push_back(std::move(channel));
+}
+
+/**
+ * Add a machine
+ * @param name Machine name
+ * @param position Machine position
+ * @param machineNumber Machine number
+ * @param startFrame Frame the machine starts on
+ * @param scale Drawing scale
+ */
+void AnimBinaryWriter::AddMachine(const std::wstring& name, wxPoint position, int machineNumber, int startFrame, double scale)
+{
+    Machine machine;
+    machine.mName = ToUTF8(name);
+    memset(&machine.mRecord, 0, sizeof(machine.mRecord));
+    machine.mRecord.mX = position.x;
+    machine.mRecord.mY = position.y;
+    machine.mRecord.mMachineNumber = machineNumber;
+    machine.mRecord.mStartFrame = startFrame;
+    machine.mRecord.mScale = scale;
+    mMachines.push_back(machine);
+}
+
+/**
+ * Write the binary animation file
+ * @param filename File to write
+ * @return true if the file was written
+ */
+bool AnimBinaryWriter::Write(const std::wstring& filename) const
+{
+    AnimBinary::Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.mMagic, AnimBinary::GetMagic(), sizeof(header.mMagic));
+    header.mVersion = AnimBinary::Version;
+    header.mByteOrder = AnimBinary::ByteOrderMark;
+    header.mNumFrames = mNumFrames;
+    header.mFrameRate = mFrameRate;
+    header.mNumChannels = (uint32_t)mChannels.size();
+    header.mNumMachines = (uint32_t)mMachines.size();
+
+    //
+    // Lay out the names and then the keyframe arrays
+    //
+    std::string names;
+    std::vector<AnimBinary::ChannelRecord> channels(mChannels.size());
+    std::vector<AnimBinary::MachineRecord> machines(mMachines.size());
+
+    for (size_t i = 0; i < mChannels.size(); i++)
+    {
+        memset(&channels[i], 0, sizeof(channels[i]));
+        channels[i].mNameOffset = (uint32_t)names.size();
+        channels[i].mNameLength = (uint32_t)mChannels[i].mName.size();
+        channels[i].mType = uint32_t(mChannels[i].mType);
+        channels[i].mNumKeyframes = (uint32_t)mChannels[i].mFrames.size();
+        names += mChannels[i].mName;
+    }
+
+    for (size_t i = 0; i < mMachines.size(); i++)
+    {
+        machines[i] = mMachines[i].mRecord;
+        machines[i].mNameOffset = (uint32_t)names.size();
+        machines[i].mNameLength = (uint32_t)mMachines[i].mName.size();
+        names += mMachines[i].mName;
+    }
+
+    header.mNamesOffset = sizeof(header) +
+            channels.size() * sizeof(AnimBinary::ChannelRecord) +
+            machines.size() * sizeof(AnimBinary::MachineRecord);
+    header.mNamesSize = names.size();
+
+    uint64_t offset = Align(header.mNamesOffset + header.mNamesSize);
+    for (size_t i = 0; i < mChannels.size(); i++)
+    {
+        auto& channel = mChannels[i];
+        channels[i].mFramesOffset = offset;
+        offset = Align(offset + channel.mFrames.size() * sizeof(int32_t));
+
+        channels[i].mValuesOffset = offset;
+        offset = Align(offset + (channel.mType == AnimBinary::ChannelType::Angle ?
+                channel.mAngles.size() * sizeof(double) :
+                channel.mPoints.size() * sizeof(int32_t)));
+    }
+
+    //
+    // And write it all in order
+    //
+    std::ofstream file(wxString(filename).fn_str(), std::ios::binary);
+    uint64_t written = 0;
+    auto write = [&file, &written](const void* data, uint64_t size) {
+        file.write(static_cast<const char*>(data), size);
+        written += size;
+    };
+
+    auto pad = [&file, &written]() {
+        static const char zeros[8] = {0};
+        file.write(zeros, Align(written) - written);
+        written = Align(written);
+    };
+
+    write(&header, sizeof(header));
+    write(channels.data(), channels.size() * sizeof(AnimBinary::ChannelRecord));
+    write(machines.data(), machines.size() * sizeof(AnimBinary::MachineRecord));
+    write(names.data(), names.size());
+    pad();
+
+    for (auto& channel : mChannels)
+    {
+        write(channel.mFrames.data(), channel.mFrames.size() * sizeof(int32_t));
+        pad();
+
+        if (channel.mType == AnimBinary::ChannelType::Angle)
+        {
+            write(channel.mAngles.data(), channel.mAngles.size() * sizeof(double));
+        }
+        else
+        {
+            write(channel.mPoints.data(), channel.mPoints.size() * sizeof(int32_t));
+        }
+        pad();
+    }
+
+    return file.good() && written == offset;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file AnimBinaryWriter.h
+ * @author Aditya Menon
+ *
+ * Writes a binary animation file
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMBINARYWRITER_H
+#define CANADIANEXPERIENCE_ANIMBINARYWRITER_H
+
+#include <string>
+#include <vector>
+#include "AnimBinary.h"
+
+/**
+ * Writes a binary animation file.
+ *
+ * The timeline settings, channels and machines are added and
+ * then Write lays them out as described in AnimBinary.
+ */
+class AnimBinaryWriter
+{
+private:
+    /// A channel to write
+    struct Channel
+    {
+        std::string mName;                  ///< Name in UTF-8
+        AnimBinary::ChannelType mType;      ///< Channel type
+        std::vector<int32_t> mFrames;       ///< Keyframe frames
+        std::vector<double> mAngles;        ///< Angles of an angle channel
+        std::vector<int32_t> mPoints;       ///< x,y pairs of a point channel
+    };
+
+    /// A machine to write
+    struct Machine
+    {
+        std::string mName;                  ///< Name in UTF-8
+        AnimBinary::MachineRecord mRecord;  ///< The settings
+    };
+
+    /// Timeline number of frames
+    int mNumFrames = 0;
+
+    /// Timeline frame rate
+    int mFrameRate = 30;
+
+    /// The channels
+    std::vector<Channel> mChannels;
+
+    /// The machines
+    std::vector<Machine> mMachines;
+
+public:
+    AnimBinaryWriter() {}
+
+    /// Copy constructor (disabled)
+    AnimBinaryWriter(const AnimBinaryWriter &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const AnimBinaryWriter &) = delete;
+
+    /**
+     * Set the timeline settings
+     * @param numFrames Number of frames
+     * @param frameRate Frames per second
+     */
+    void SetTimeline(int numFrames, int frameRate) { mNumFrames = numFrames; mFrameRate = frameRate; }
+
+    void AddAngleChannel(const std::wstring& name, const std::vector<int>& frames, const std::vector<double>& angles);
+    void AddPointChannel(const std::wstring& name, const std::vector<int>& frames, const std::vector<wxPoint>& points);
+    void AddMachine(const std::wstring& name, wxPoint position, int machineNumber, int startFrame, double scale);
+
+    bool Write(const std::wstring& filename) const;
+};
+
+#endif //CANADIANEXPERIENCE_ANIMBINARYWRITER_H
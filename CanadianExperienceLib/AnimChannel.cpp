@@ -4,20 +4,27 @@
  */
 
 #include "pch.h"
+#include <algorithm>
 #include "AnimChannel.h"
 
 #include "Timeline.h"
+#include "XmlStreamReader.h"
 
 
 /**
- * Determine how we should insert a keyframe into our keyframe list.
- * @param keyframe The keyframe to insert
+ * Determine how we should insert a keyframe for the current
+ * frame into our keyframe list and add its frame.
+ * @return Index of the keyframe for the current frame
  */
-void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
+int AnimChannel::InsertFrame()
 {
-    // Get the current frame and tell it to the keyframe we are setting.
+    // Get the current frame, which is the frame of the keyframe we are setting.
     int currFrame = mTimeline->GetCurrentFrame();
-    keyframe->SetFrame(currFrame);
+
+    // The timeline may have read our baked samples rather than
+    // moving us to the current frame, so make sure we are there
+    SetFrame(currFrame);
+    Modified();
 
     // The possible options for keyframe insertion
     enum class Action { Append, Replace, Insert } action;
@@ -34,7 +41,7 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
     {
         // We know mKeyframe1 is valid
         // So, we are after it.
-        int frame1 = mKeyframes[mKeyframe1]->GetFrame();
+        int frame1 = mFrames[mKeyframe1];
 
         if (mKeyframe2 < 0)
         {
@@ -59,23 +66,59 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
     {
     case Action::Append:
         // Add to end and the keyframe to the left becomes the new keyframe
-        mKeyframes.push_back(keyframe);
-        mKeyframe1 = (int)mKeyframes.size() - 1;
+        mFrames.push_back(currFrame);
+        mKeyframe1 = (int)mFrames.size() - 1;
         break;
 
     case Action::Replace:
-        // Replace the current keyframe
-        mKeyframes[mKeyframe1] = keyframe;
+        // Replace the current keyframe, which is already at this frame
         break;
 
     case Action::Insert:
         // Insert after mKeyframe1
         // and mKeyframe1 becomes this new insertion (frame we are on)
-        mKeyframes.insert(mKeyframes.begin() + (mKeyframe1 + 1), keyframe);
+        mFrames.insert(mFrames.begin() + (mKeyframe1 + 1), currFrame);
         mKeyframe1++;
+
+        // The keyframe that was mKeyframe2 moved up one place
+        mKeyframe2 = mKeyframe1 + 1;
         break;
     }
 
+    return mKeyframe1;
+}
+
+
+/**
+ * Add a keyframe's frame at a given frame, or find the
+ * keyframe already at that frame.
+ *
+ * The channel is left before its first keyframe, where any
+ * frame can be reached from, so the next SetFrame finds its place.
+ * @param frame Frame of the keyframe
+ * @return Index of the keyframe for the frame
+ */
+int AnimChannel::InsertFrame(int frame)
+{
+    Modified();
+    mKeyframe1 = -1;
+    mKeyframe2 = 0;
+
+    // Keyframes are saved in order, so loading appends
+    if (mFrames.empty() || mFrames.back() < frame)
+    {
+        mFrames.push_back(frame);
+        return (int)mFrames.size() - 1;
+    }
+
+    auto found = std::lower_bound(mFrames.begin(), mFrames.end(), frame);
+    int index = int(found - mFrames.begin());
+    if (*found != frame)
+    {
+        mFrames.insert(found, frame);
+    }
+
+    return index;
 }
 
 
@@ -92,22 +135,47 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
  */
 void AnimChannel::SetFrame(int currFrame)
 {
+    // A large jump, such as a seek or scrubbing the timeline, would
+    // take many steps to walk. If the walk would go further than
+    // MaxWalk keyframes in either direction, binary search instead.
+    int size = (int)mFrames.size();
+    if ((mKeyframe2 >= 0 && mKeyframe2 + MaxWalk < size && mFrames[mKeyframe2 + MaxWalk] <= currFrame) ||
+        (mKeyframe1 >= MaxWalk && mFrames[mKeyframe1 - MaxWalk] > currFrame))
+    {
+        Seek(currFrame);
+    }
+
     // Should we move forward in time?
-    while (mKeyframe2 >= 0 && mKeyframes[mKeyframe2]->GetFrame() <= currFrame)
+    while (mKeyframe2 >= 0 && mFrames[mKeyframe2] <= currFrame)
     {
         mKeyframe1 = mKeyframe2;
         mKeyframe2++;
-        if (mKeyframe2 >= (int)mKeyframes.size())
+        if (mKeyframe2 >= size)
             mKeyframe2 = -1;
     }
 
     // Should we move backwards in time?
-    while (mKeyframe1 >= 0 && mKeyframes[mKeyframe1]->GetFrame() > currFrame)
+    while (mKeyframe1 >= 0 && mFrames[mKeyframe1] > currFrame)
     {
         mKeyframe2 = mKeyframe1;
         mKeyframe1--;
     }
+}
 
+/**
+ * Get the keyframes to tween between and how far we are
+ * between them. Call SetFrame first.
+ *
+ * If only one keyframe applies, because we are before the
+ * first keyframe or after the last, both indices are that
+ * keyframe and t is 0.
+ * @param keyframe1 Set to the index of the first keyframe
+ * @param keyframe2 Set to the index of the second keyframe
+ * @param t Set to the t value (0 to 1)
+ * @return false if there are no keyframes
+ */
+bool AnimChannel::GetTween(int& keyframe1, int& keyframe2, double& t)
+{
     // Four possibilities here:
     // No keyframes  (mKeyframe1 < 0 and mKeyframe2 < 0)
     // Only a keyframe to the left (mKeyframe1 >= 0 and mKeyframe2 < 0)
@@ -117,28 +185,49 @@ void AnimChannel::SetFrame(int currFrame)
     {
         // Between two keyframes
         // So we have to tween
-        mKeyframes[mKeyframe1]->UseAs1();
-        mKeyframes[mKeyframe2]->UseAs2();
 
         // Compute the t value
         double frameRate = GetTimeline()->GetFrameRate();
-        double time1 = mKeyframes[mKeyframe1]->GetFrame() / frameRate;
-        double time2 = mKeyframes[mKeyframe2]->GetFrame() / frameRate;
-        double t = (GetTimeline()->GetCurrentTime() - time1) / (time2 - time1);
+        double time1 = mFrames[mKeyframe1] / frameRate;
+        double time2 = mFrames[mKeyframe2] / frameRate;
+        t = (GetTimeline()->GetCurrentTime() - time1) / (time2 - time1);
 
-        // And tween
-        Tween(t);
+        keyframe1 = mKeyframe1;
+        keyframe2 = mKeyframe2;
+        return true;
     }
     else if (mKeyframe1 >= 0)
     {
         // We are only using keyframe 1
-        mKeyframes[mKeyframe1]->UseOnly();
+        keyframe1 = keyframe2 = mKeyframe1;
+        t = 0;
+        return true;
     }
     else if (mKeyframe2 >= 0)
     {
         // We are only using keyframe 2
-        mKeyframes[mKeyframe2]->UseOnly();
+        keyframe1 = keyframe2 = mKeyframe2;
+        t = 0;
+        return true;
     }
+
+    return false;
+}
+
+/**
+ * Set the keyframe indices for a frame directly by a binary
+ * search of the keyframe frames.
+ *
+ * Afterwards mKeyframe1 is the last keyframe at or before
+ * the frame and mKeyframe2 the one after it, either of
+ * which may be -1, just as if we had walked there.
+ * @param currFrame The frame we are on.
+ */
+void AnimChannel::Seek(int currFrame)
+{
+    auto next = std::upper_bound(mFrames.begin(), mFrames.end(), currFrame);
+    mKeyframe1 = int(next - mFrames.begin()) - 1;
+    mKeyframe2 = next == mFrames.end() ? -1 : int(next - mFrames.begin());
 }
 
 /**
@@ -146,23 +235,27 @@ void AnimChannel::SetFrame(int currFrame)
  */
 void AnimChannel::ClearKeyframe()
 {
+    // Make sure we are on the current frame, in case the
+    // timeline read our baked samples rather than moving us
+    int currFrame = GetTimeline()->GetCurrentFrame();
+    SetFrame(currFrame);
+
     // If there is no keyframe1, we are not on a keyframe
     if (mKeyframe1 < 0)
         return;
 
     // We know mKeyframe1 is valid
     // Determine the frame number for the first keyframe
-    int frame1 = mKeyframes[mKeyframe1]->GetFrame();
-
-    // What is the current frame?
-    int currFrame = GetTimeline()->GetCurrentFrame();
+    int frame1 = mFrames[mKeyframe1];
 
     // This is only valid if we are on a keyframe, as
     // indicated by mKeyframe1 equal to the current frame.
     if (frame1 != currFrame)
         return;
 
-    mKeyframes.erase(mKeyframes.begin() + mKeyframe1);
+    mFrames.erase(mFrames.begin() + mKeyframe1);
+    RemoveKeyframe(mKeyframe1);
+    Modified();
 
     // The current frame becomes the previous frame
     // or -1 if we are on frame 0
@@ -185,65 +278,57 @@ wxXmlNode* AnimChannel::XmlSave(wxXmlNode* node)
 
     itemNode->AddAttribute(L"name", mName);
 
-    for (auto keyframe : mKeyframes)
+    for (int i = 0; i < (int)mFrames.size(); i++)
     {
-        keyframe->XmlSave(itemNode);
+        auto keyframeNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
+        itemNode->AddChild(keyframeNode);
+
+        keyframeNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), mFrames[i]));
+        XmlSaveKeyframe(keyframeNode, i);
     }
 
     return itemNode;
 }
 
 
+
 /**
- * Save this keyframe to an XML node
- * @param node The node we are going to be a child of
- * @return Allocated XML node
+ * Handle a keyframe element read by the streaming loader.
+ *
+ * This does not move the timeline to the keyframe, so loading
+ * does not evaluate every channel for every keyframe.
+ * @param element The keyframe element
  */
-wxXmlNode* AnimChannel::Keyframe::XmlSave(wxXmlNode* node)
+void AnimChannel::XmlStreamKeyframe(const XmlStreamElement& element)
 {
-    auto itemNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
-    node->AddChild(itemNode);
-
-    itemNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), mFrame));
-
-    return itemNode;
+    XmlStreamLoadKeyframe(element, element.GetAttributeInt("frame", 0));
 }
 
 
-
 /**
-* Handle loading this channel from a channel tag.
-* @param node channel tag node
-*/
-void AnimChannel::XmlLoad(wxXmlNode* node)
+ * Clear all keyframes for this channel.
+ */
+void AnimChannel::Clear()
 {
-    //
-    // Traverse the children of the node
-    //
-    auto child = node->GetChildren();
-    for( ; child; child=child->GetNext())
-    {
-        auto name = child->GetName();
-        if(name == L"keyframe")
-        {
-            int frame = wxAtoi(child->GetAttribute(L"frame", L"0"));
-
-            // Pretend we are at that time
-            GetTimeline()->SetCurrentTime(double(frame) / double(GetTimeline()->GetFrameRate()));
-
-            // Have the derived class set the keyframe
-            XmlLoadKeyframe(child);
-        }
-    }
+    mFrames.clear();
+    Modified();
+    mKeyframe1 = -1;
+    mKeyframe2 = -1;
 }
 
-
 /**
- * Clear all keyframes for this channel.
+ * Replace all of the keyframe frames at once, as when loading.
+ *
+ * The channel type sets its keyframe values to match. The channel
+ * is left before the first keyframe, so the next SetFrame finds
+ * its place.
+ * @param frames Frames of the keyframes in increasing order
+ * @param count Number of keyframes
  */
-void AnimChannel::Clear()
+void AnimChannel::SetKeyframeFrames(const int32_t* frames, int count)
 {
-    mKeyframes.clear();
+    mFrames.assign(frames, frames + count);
+    Modified();
     mKeyframe1 = -1;
-    mKeyframe2 = -1;
-}
\ No newline at end of file
+    mKeyframe2 = count > 0 ? 0 : -1;
+}
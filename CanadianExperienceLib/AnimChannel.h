@@ -11,6 +11,7 @@
 
 
 class Timeline;
+class XmlStreamElement;
 
 /**
  * Base class for an animation channel
@@ -29,60 +30,35 @@ private:
     /// The timeline object
     Timeline *mTimeline = nullptr;
 
-protected:
-    /// Default constructor
-    AnimChannel() {}
-    
-    /// Class that represents a keyframe
-    class Keyframe
-    {
-    public:
-        /** Default constructor disabled */
-        Keyframe() = delete;
-        /** Copy constructor disabled */
-        Keyframe(const Keyframe &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const Keyframe &) = delete;
-
-        /**
-         * Get the frame for this keyframe
-         * @return The keyframe frame number
-         */
-        int GetFrame() const { return mFrame; }
-
-        /**
-         * Set the frame for this keyframe
-         * @param f The new frame number to set
-         */
-        void SetFrame(int f) { mFrame = f; }
+    /// The ID of this channel in its timeline, or -1 if not on a timeline
+    int mId = -1;
 
-        /// Indicates this keyframe is used as Keyframe1
-        virtual void UseAs1() = 0;
+    /// The frame of each keyframe in order. Kept apart from the
+    /// keyframe values so a seek can binary search contiguous ints.
+    std::vector<int> mFrames;
 
-        /// Indicates this keyframe is used as Keyframe2
-        virtual void UseAs2() = 0;
+    /// True if the timeline's baked samples of this channel are current
+    bool mBaked = false;
 
-        /// Indicates this is the only keyframe
-        virtual void UseOnly() = 0;
+    /// Incremented every time the keyframes change
+    unsigned mRevision = 0;
 
-        virtual wxXmlNode* XmlSave(wxXmlNode* node);
+    void Seek(int currFrame);
 
-    private:
-        /// The channel this keyframe is associated with
-        AnimChannel *mChannel;
-
-        int mFrame; ///< The frame number for the keyframe
-
-    protected:
-        /**
-         * Constructor
-         * @param channel Channel we are associated with
-         */
-        Keyframe(AnimChannel *channel) : mChannel(channel) {}
+    /**
+     * Note that the keyframes have changed
+     */
+    void Modified() { mBaked = false; mRevision++; }
 
-    };
+protected:
+    /// Default constructor
+    AnimChannel() {}
 
 public:
+    /// Number of keyframes SetFrame will step over one at a time
+    /// before it switches to a binary search
+    static const int MaxWalk = 4;
+
     /// Destructor
     virtual ~AnimChannel() {}
 
@@ -113,6 +89,19 @@ public:
      */
     Timeline *GetTimeline() { return mTimeline; }
 
+    /**
+     * Get the ID of this channel in its timeline. The ID does not
+     * change for as long as the channel is on the timeline.
+     * @return Channel ID or -1 if not on a timeline
+     */
+    int GetId() const { return mId; }
+
+    /**
+     * Set the ID of this channel in its timeline
+     * @param id The channel ID
+     */
+    void SetId(int id) { mId = id; }
+
     void SetFrame(int currFrame);
 
     /**
@@ -122,28 +111,115 @@ public:
     bool IsValid() { return mKeyframe1 >= 0 || mKeyframe2 >= 0; }
     void ClearKeyframe();
 
+    /**
+     * Determine if the timeline's baked samples of this channel
+     * are current, meaning the keyframes have not changed since
+     * @return true if the samples can be used
+     */
+    bool IsBaked() const { return mBaked; }
+
+    /**
+     * Set whether the timeline's baked samples of this channel are current
+     * @param baked true once the timeline has sampled this channel
+     */
+    void SetBaked(bool baked) { mBaked = baked; }
+
+    /**
+     * Get the revision of the keyframes. It changes every
+     * time the keyframes do, so a copy of the keyframes is
+     * current as long as the revision is the same.
+     * @return Keyframe revision
+     */
+    unsigned GetRevision() const { return mRevision; }
+
+    /**
+     * Get the frame of each keyframe
+     * @return The frames in increasing order
+     */
+    const std::vector<int>& GetKeyframeFrames() const { return mFrames; }
+
     virtual void Clear();
     virtual wxXmlNode* XmlSave(wxXmlNode* node);
-    virtual void XmlLoad(wxXmlNode* node);
+    void XmlStreamKeyframe(const XmlStreamElement& element);
 
 private:
-    /// The collection of keyframes for this channel
-    std::vector<std::shared_ptr<Keyframe>> mKeyframes;
+    int InsertFrame();
+    int InsertFrame(int frame);
 
 protected:
-    void InsertKeyframe(std::shared_ptr<Keyframe> keyframe);
+    /**
+     * Insert a keyframe at the current frame into the channel.
+     *
+     * Keyframes are stored by value. The frames are kept here and
+     * each channel type keeps its keyframe values in a vector
+     * in the same order, so keyframe i is mFrames[i] and values[i].
+     * @param values The channel's keyframe values
+     * @param value The value for the new keyframe
+     */
+    template<class T>
+    void InsertKeyframe(std::vector<T>& values, const T& value)
+    {
+        int index = InsertFrame();
+
+        // If there is now one more frame than values, the keyframe
+        // is a new one. Otherwise it replaces the one at this frame.
+        if (values.size() < mFrames.size())
+        {
+            values.insert(values.begin() + index, value);
+        }
+        else
+        {
+            values[index] = value;
+        }
+    }
+
+    /**
+     * Insert a keyframe at a given frame into the channel,
+     * replacing any keyframe already at that frame. This does
+     * not move the channel to the frame, so it is fast when
+     * loading many keyframes.
+     * @param values The channel's keyframe values
+     * @param frame Frame of the keyframe
+     * @param value The value for the keyframe
+     */
+    template<class T>
+    void InsertKeyframe(std::vector<T>& values, int frame, const T& value)
+    {
+        int index = InsertFrame(frame);
+        if (values.size() < mFrames.size())
+        {
+            values.insert(values.begin() + index, value);
+        }
+        else
+        {
+            values[index] = value;
+        }
+    }
 
     /**
-     * Channel type specific loading and keyframe creation
-     * @param node Node to load from
+     * Channel type specific loading of a keyframe element
+     * read by the streaming loader
+     * @param element The keyframe element
+     * @param frame Frame of the keyframe
      */
-    virtual void XmlLoadKeyframe(wxXmlNode* node) = 0;
+    virtual void XmlStreamLoadKeyframe(const XmlStreamElement& element, int frame) = 0;
 
     /**
-     * Tween between two keyframes
-     * @param t The T value (0 to 1)
-     * */
-    virtual void Tween(double t) = 0;
+     * Channel type specific saving of a keyframe's value
+     * @param node The keyframe node to add the value to
+     * @param keyframe Index of the keyframe to save
+     */
+    virtual void XmlSaveKeyframe(wxXmlNode* node, int keyframe) = 0;
+
+    /**
+     * Remove the value of a keyframe that is being cleared
+     * @param keyframe Index of the keyframe
+     */
+    virtual void RemoveKeyframe(int keyframe) = 0;
+
+    void SetKeyframeFrames(const int32_t* frames, int count);
+
+    bool GetTween(int& keyframe1, int& keyframe2, double& t);
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNEL_H
@@ -5,70 +5,102 @@
 
 #include "pch.h"
 #include "AnimChannelAngle.h"
+#include "Timeline.h"
+#include "XmlStreamReader.h"
 
 
 /**
  * Set a keyframe
  *
- * This function allocates a new keyframe and sends it to
- * AnimChannel, which will insert it into the collection of keyframes.
+ * AnimChannel determines where the keyframe goes
+ * in the collection of keyframes.
  * @param angle Angle for the keyframe.
  */
 void AnimChannelAngle::SetKeyframe(double angle)
 {
-    // Create a keyframe of the appropriate type
-    // Telling it this channel and the angle
-    auto keyframe = std::make_shared<KeyframeAngle>(this, angle);
-
-    // Insert it into the collection
-    InsertKeyframe(keyframe);
+    InsertKeyframe(mAngles, angle);
 }
 
 
 /**
- * Compute an angle that is an interpolation
- * between two keyframes
- *
- * This function is called after Use1 and Use2,
- * so we have pointers to valid keyframes of the
- * type KeyframeAngle. This function computes the
- * tweening.
- *
- * @param t A t value. t=0 means keyframe1, t=1 means keyframe2.
- * Other values interpolate between.
+ * Get the current time angle
+ * @return Angle in radians
  */
-void AnimChannelAngle::Tween(double t)
+double AnimChannelAngle::GetAngle()
 {
-    mAngle = mKeyframe1->GetAngle() * (1 - t) +
-            mKeyframe2->GetAngle() * t;
+    return mSlot >= 0 ? GetTimeline()->GetAngle(mSlot) : 0;
 }
 
-/** Save this keyframe to an XML node
-* @param node The node we are going to be a child of
-* @return Allocated XML node.
-*/
-wxXmlNode* AnimChannelAngle::KeyframeAngle::XmlSave(wxXmlNode* node)
+/**
+ * Compute the angle for a frame, an interpolation
+ * between the two keyframes around it.
+ *
+ * If only one keyframe applies, both indices are the
+ * same and t is 0, which gives that keyframe's angle.
+ *
+ * @param currFrame The frame we are on
+ * @param angle Set to the angle if the channel has keyframes
+ */
+void AnimChannelAngle::Evaluate(int currFrame, double& angle)
 {
-    auto itemNode = AnimChannel::Keyframe::XmlSave(node);
-    itemNode->AddAttribute(L"angle", wxString::Format(wxT("%f"), mAngle));
+    SetFrame(currFrame);
 
-    return itemNode;
+    int keyframe1, keyframe2;
+    double t;
+    if (GetTween(keyframe1, keyframe2, t))
+    {
+        angle = mAngles[keyframe1] * (1 - t) +
+                mAngles[keyframe2] * t;
+    }
 }
 
+/**
+ * Remove the angle of a keyframe that is being cleared
+ * @param keyframe Index of the keyframe
+ */
+void AnimChannelAngle::RemoveKeyframe(int keyframe)
+{
+    mAngles.erase(mAngles.begin() + keyframe);
+}
 
+/**
+ * Clear all keyframes for this channel.
+ */
+void AnimChannelAngle::Clear()
+{
+    AnimChannel::Clear();
+    mAngles.clear();
+}
 
 /**
-* Handle loading this channel's keyframe type
-* @param node keyframe tag node
+ * Replace all of the keyframes at once, as when loading
+ * @param frames Frames of the keyframes in increasing order
+ * @param angles Angles of the keyframes in radians
+ * @param count Number of keyframes
+ */
+void AnimChannelAngle::SetKeyframes(const int32_t* frames, const double* angles, int count)
+{
+    SetKeyframeFrames(frames, count);
+    mAngles.assign(angles, angles + count);
+}
+
+/** Save the angle of a keyframe to its XML node
+* @param node The keyframe node
+* @param keyframe Index of the keyframe to save
 */
-void AnimChannelAngle::XmlLoadKeyframe(wxXmlNode* node)
+void AnimChannelAngle::XmlSaveKeyframe(wxXmlNode* node, int keyframe)
 {
-    auto angleStr = node->GetAttribute(L"angle", L"0");
+    node->AddAttribute(L"angle", wxString::Format(wxT("%f"), mAngles[keyframe]));
+}
 
-    double angle;
-    angleStr.ToDouble(&angle);
 
-    // Set a keyframe there
-    SetKeyframe(angle);
-}
 
+/**
+* Handle loading an angle keyframe read by the streaming loader
+* @param element keyframe element
+* @param frame Frame of the keyframe
+*/
+void AnimChannelAngle::XmlStreamLoadKeyframe(const XmlStreamElement& element, int frame)
+{
+    InsertKeyframe(mAngles, frame, element.GetAttributeDouble("angle", 0));
+}
@@ -13,74 +13,40 @@
 /**
  * Animation channel for angles
  */
-class AnimChannelAngle : public AnimChannel {
+class AnimChannelAngle final : public AnimChannel {
 private:
-    double mAngle = 0;  ///< The computed animation angle
+    /// Index of this channel's angle in the timeline's
+    /// angle buffer, or -1 if it is not on a timeline
+    int mSlot = -1;
 
-protected:
-    /// A keyframe for an angle channel
-    class KeyframeAngle : public Keyframe
-    {
-    public:
-        /**
-         * Constructor
-         * @param channel The channel we are for
-         * @param angle The angle for the keyframe
-         */
-        KeyframeAngle(AnimChannelAngle *channel, double angle) :
-            Keyframe(channel), mChannel(channel), mAngle(angle) {}
-
-        /** Default constructor disabled */
-        KeyframeAngle() = delete;
-        /** Copy constructor disabled */
-        KeyframeAngle(const KeyframeAngle &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const KeyframeAngle &) = delete;
-
-        /**
-         * Get the angle at this keyframe
-         * @return Angle in radians
-         */
-        double GetAngle() { return mAngle; }
-
-        /// Use this keyframe as keyframe 1
-        void UseAs1() override { mChannel->mKeyframe1 = this; }
-
-        /// Use this keyframe as keyfraem 2
-        void UseAs2() override { mChannel->mKeyframe2 = this; }
-
-        /// Use this keyframe as the angle
-        void UseOnly() override { mChannel->mAngle = mAngle; }
-
-    private:
-        double mAngle;  ///< The angle for this keyframe
-
-        /// The channel this keyframe is associated with
-        AnimChannelAngle *mChannel;
-
-        wxXmlNode* XmlSave(wxXmlNode* node) override;
-    };
+    /// The angle of each keyframe in radians, in keyframe order
+    std::vector<double> mAngles;
 
 protected:
-    void XmlLoadKeyframe(wxXmlNode* node) override;
-
-    /// The first angle keyframe
-    KeyframeAngle *mKeyframe1 = nullptr;
-
-    /// The second angle keyframe
-    KeyframeAngle *mKeyframe2 = nullptr;
+    void XmlSaveKeyframe(wxXmlNode* node, int keyframe) override;
+    void RemoveKeyframe(int keyframe) override;
+    void XmlStreamLoadKeyframe(const XmlStreamElement& element, int frame) override;
 
 public:
     AnimChannelAngle() {}
 
+    double GetAngle();
+    void SetKeyframe(double angle);
+    void Clear() override;
+    void Evaluate(int currFrame, double& angle);
+    void SetKeyframes(const int32_t* frames, const double* angles, int count);
+
     /**
-     * Get the current time angle
-     * @return Angle in radians
+     * Get the angle of each keyframe
+     * @return Angles in radians, in keyframe order
      */
-    double GetAngle() { return mAngle; }
+    const std::vector<double>& GetKeyframeAngles() const { return mAngles; }
 
-    void SetKeyframe(double angle);
-    void Tween(double t) override;
+    /**
+     * Set the index of this channel's angle in the timeline's angle buffer
+     * @param slot Index into the buffer
+     */
+    void SetSlot(int slot) { mSlot = slot; }
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNELANGLE_H
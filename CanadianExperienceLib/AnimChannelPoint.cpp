@@ -5,64 +5,106 @@
 
 #include "pch.h"
 #include "AnimChannelPoint.h"
+#include "Timeline.h"
+#include "XmlStreamReader.h"
 
 /**
  * Set a keyframe
  *
- * This function allocates a new keyframe and sends it to
- * AnimChannel, which will insert it into the collection of keyframes.
+ * AnimChannel determines where the keyframe goes
+ * in the collection of keyframes.
  * @param point The point for the keyframe
  */
 void AnimChannelPoint::SetKeyframe(wxPoint point)
 {
-    // Create a keyframe of the appropriate type
-    // Telling it this channel and the angle
-    std::shared_ptr<KeyframePoint> keyframe = std::make_shared<KeyframePoint>(this, point);
+    InsertKeyframe(mPoints, point);
+}
 
-    // Insert it into the collection
-    InsertKeyframe(keyframe);
+/**
+ * Get the current time point
+ * @return The computed point
+ */
+wxPoint AnimChannelPoint::GetPoint()
+{
+    return mSlot >= 0 ? GetTimeline()->GetPoint(mSlot) : wxPoint(0, 0);
 }
 
-/** Compute a tweened point between to points
- * @param t The tweening t value 
+/** Compute a tweened point for a frame between
+ * the two keyframes around it
+ * @param currFrame The frame we are on
+ * @param point Set to the point if the channel has keyframes
  */
-void AnimChannelPoint::Tween(double t)
+void AnimChannelPoint::Evaluate(int currFrame, wxPoint& point)
 {
-    auto a = mKeyframe1->GetPoint();
-    auto b = mKeyframe2->GetPoint();
+    SetFrame(currFrame);
 
-    mPoint = wxPoint(int(a.x + t * (b.x - a.x)),
-            int(a.y + t * (b.y - a.y)));
-}
+    int keyframe1, keyframe2;
+    double t;
+    if (GetTween(keyframe1, keyframe2, t))
+    {
+        auto a = mPoints[keyframe1];
+        auto b = mPoints[keyframe2];
 
+        point = wxPoint(int(a.x + t * (b.x - a.x)),
+                int(a.y + t * (b.y - a.y)));
+    }
+}
 
-/** Save this keyframe to an XML node
-* @param node The node we are going to be a child of
-* @return Allocated XML node.
-*/
-wxXmlNode* AnimChannelPoint::KeyframePoint::XmlSave(wxXmlNode* node)
+/**
+ * Remove the point of a keyframe that is being cleared
+ * @param keyframe Index of the keyframe
+ */
+void AnimChannelPoint::RemoveKeyframe(int keyframe)
 {
-    auto itemNode = AnimChannel::Keyframe::XmlSave(node);
-    itemNode->AddAttribute(L"x", wxString::Format(wxT("%i"), mPoint.x));
-    itemNode->AddAttribute(L"y", wxString::Format(wxT("%i"), mPoint.y));
+    mPoints.erase(mPoints.begin() + keyframe);
+}
 
-    return itemNode;
+/**
+ * Clear all keyframes for this channel.
+ */
+void AnimChannelPoint::Clear()
+{
+    AnimChannel::Clear();
+    mPoints.clear();
 }
 
+/**
+ * Replace all of the keyframes at once, as when loading
+ * @param frames Frames of the keyframes in increasing order
+ * @param points The keyframe points as x,y pairs
+ * @param count Number of keyframes
+ */
+void AnimChannelPoint::SetKeyframes(const int32_t* frames, const int32_t* points, int count)
+{
+    SetKeyframeFrames(frames, count);
+    mPoints.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        mPoints[i] = wxPoint(points[i * 2], points[i * 2 + 1]);
+    }
+}
 
 
-/**
-* Handle loading this channel's keyframe type
-* @param node keyframe tag node
+/** Save the point of a keyframe to its XML node
+* @param node The keyframe node
+* @param keyframe Index of the keyframe to save
 */
-void AnimChannelPoint::XmlLoadKeyframe(wxXmlNode* node)
+void AnimChannelPoint::XmlSaveKeyframe(wxXmlNode* node, int keyframe)
 {
-    int x = wxAtoi(node->GetAttribute(L"x", L"0"));
-    int y = wxAtoi(node->GetAttribute(L"y", L"0"));
-
-    // Set a keyframe there
-    SetKeyframe(wxPoint(x, y));
+    auto point = mPoints[keyframe];
+    node->AddAttribute(L"x", wxString::Format(wxT("%i"), point.x));
+    node->AddAttribute(L"y", wxString::Format(wxT("%i"), point.y));
 }
 
 
 
+/**
+* Handle loading a point keyframe read by the streaming loader
+* @param element keyframe element
+* @param frame Frame of the keyframe
+*/
+void AnimChannelPoint::XmlStreamLoadKeyframe(const XmlStreamElement& element, int frame)
+{
+    wxPoint point(element.GetAttributeInt("x", 0), element.GetAttributeInt("y", 0));
+    InsertKeyframe(mPoints, frame, point);
+}
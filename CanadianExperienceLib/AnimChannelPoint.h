@@ -13,74 +13,41 @@
 /**
  * An animation channel specific to points (translational movement)
  */
-class AnimChannelPoint : public AnimChannel {
+class AnimChannelPoint final : public AnimChannel {
 private:
-    /// The point we compute
-    wxPoint mPoint = wxPoint(0, 0);
+    /// Index of this channel's point in the timeline's
+    /// point buffer, or -1 if it is not on a timeline
+    int mSlot = -1;
 
 public:
     AnimChannelPoint() = default;
 
+    wxPoint GetPoint();
+    void SetKeyframe(wxPoint point);
+    void Clear() override;
+    void Evaluate(int currFrame, wxPoint& point);
+    void SetKeyframes(const int32_t* frames, const int32_t* points, int count);
+
     /**
-     * The point we compute
-     * @return  The computed point
+     * Get the point of each keyframe
+     * @return Points in keyframe order
      */
-    wxPoint GetPoint() { return mPoint; }
-
-    /// A keyframe for a point channel
-    class KeyframePoint : public Keyframe
-    {
-    private:
-        /// The keyframe point
-        wxPoint mPoint = wxPoint(0, 0);
-
-        /// The channel this keyframe is associated with
-        AnimChannelPoint *mChannel;
-
-    public:
-        /**
-         * Constructor
-         * @param channel The channel we are for
-         * @param point The animation position for the keyframe
-         */
-        KeyframePoint(AnimChannelPoint *channel, wxPoint point) :
-                Keyframe(channel), mChannel(channel), mPoint(point) {}
-
-        /** Default constructor disabled */
-        KeyframePoint() = delete;
-        /** Copy constructor disabled */
-        KeyframePoint(const KeyframePoint &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const KeyframePoint &) = delete;
-
-        /// The keyframe point
-        /// @return The keyframe point
-        wxPoint GetPoint() { return mPoint; }
-
-        /** Use this keyframe as keyframe 1 */
-        void UseAs1() override { mChannel->mKeyframe1 = this; }
+    const std::vector<wxPoint>& GetKeyframePoints() const { return mPoints; }
 
-        /** Use this keyframe as keyfraem 2 */
-        void UseAs2() override { mChannel->mKeyframe2 = this; }
-
-        /** Use this keyframe as the angle */
-        void UseOnly() override { mChannel->mPoint = mPoint; }
-
-        wxXmlNode* XmlSave(wxXmlNode* node) override;
-    };
-
-    void SetKeyframe(wxPoint point);
-    void Tween(double t) override;
+    /**
+     * Set the index of this channel's point in the timeline's point buffer
+     * @param slot Index into the buffer
+     */
+    void SetSlot(int slot) { mSlot = slot; }
 
 private:
-    /// The first angle keyframe
-    KeyframePoint *mKeyframe1 = nullptr;
-
-    /// The second angle keyframe
-    KeyframePoint *mKeyframe2 = nullptr;
+    /// The point of each keyframe, in keyframe order
+    std::vector<wxPoint> mPoints;
 
 protected:
-    void XmlLoadKeyframe(wxXmlNode* node) override;
+    void XmlSaveKeyframe(wxXmlNode* node, int keyframe) override;
+    void RemoveKeyframe(int keyframe) override;
+    void XmlStreamLoadKeyframe(const XmlStreamElement& element, int frame) override;
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNELPOINT_H
@@ -0,0 +1,198 @@
+/**
+ * @file AnimConverter.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include "AnimConverter.h"
+#include "AnimBinary.h"
+#include "AnimBinaryWriter.h"
+
+/// A keyframe read from XML
+struct XmlKeyframe
+{
+    int mFrame;         ///< Keyframe frame
+    double mAngle;      ///< Angle, for an angle channel
+    wxPoint mPoint;     ///< Point, for a point channel
+};
+
+/**
+ * Convert an XML animation file to the binary format
+ * @param xmlFile XML file to read
+ * @param binaryFile Binary file to write
+ * @return true if successful
+ */
+bool AnimConverter::XmlToBinary(const std::wstring& xmlFile, const std::wstring& binaryFile)
+{
+    wxXmlDocument document;
+    if (!document.Load(xmlFile))
+    {
+        return false;
+    }
+
+    auto root = document.GetRoot();
+    AnimBinaryWriter writer;
+    writer.SetTimeline(wxAtoi(root->GetAttribute(L"numframes", L"300")),
+            wxAtoi(root->GetAttribute(L"framerate", L"30")));
+
+    for (auto node = root->GetChildren(); node; node = node->GetNext())
+    {
+        if (node->GetName() == L"channel")
+        {
+            std::vector<XmlKeyframe> keyframes;
+            bool point = false;
+            for (auto child = node->GetChildren(); child; child = child->GetNext())
+            {
+                if (child->GetName() == L"keyframe")
+                {
+                    XmlKeyframe keyframe;
+                    keyframe.mFrame = wxAtoi(child->GetAttribute(L"frame", L"0"));
+                    keyframe.mAngle = 0;
+                    child->GetAttribute(L"angle", L"0").ToDouble(&keyframe.mAngle);
+                    keyframe.mPoint = wxPoint(wxAtoi(child->GetAttribute(L"x", L"0")),
+                            wxAtoi(child->GetAttribute(L"y", L"0")));
+                    point = point || child->HasAttribute(L"x");
+                    keyframes.push_back(keyframe);
+                }
+            }
+
+            // Loading the XML sets the keyframes in file order and a later
+            // keyframe on the same frame replaces an earlier one. The binary
+            // format requires increasing frames, so sort and keep the last.
+            std::stable_sort(keyframes.begin(), keyframes.end(),
+                    [](const XmlKeyframe& a, const XmlKeyframe& b) { return a.mFrame < b.mFrame; });
+
+            std::vector<int> frames;
+            std::vector<double> angles;
+            std::vector<wxPoint> points;
+            for (auto& keyframe : keyframes)
+            {
+                if (!frames.empty() && frames.back() == keyframe.mFrame)
+                {
+                    frames.pop_back();
+                    angles.pop_back();
+                    points.pop_back();
+                }
+
+                frames.push_back(keyframe.mFrame);
+                angles.push_back(keyframe.mAngle);
+                points.push_back(keyframe.mPoint);
+            }
+
+            auto name = node->GetAttribute(L"name", L"").ToStdWstring();
+            if (point)
+            {
+                writer.AddPointChannel(name, frames, points);
+            }
+            else
+            {
+                writer.AddAngleChannel(name, frames, angles);
+            }
+        }
+        else if (node->GetName() == L"machines")
+        {
+            for (auto machine = node->GetChildren(); machine; machine = machine->GetNext())
+            {
+                if (machine->GetName() != L"machine")
+                {
+                    continue;
+                }
+
+                wxPoint position(0, 0);
+                for (auto child = machine->GetChildren(); child; child = child->GetNext())
+                {
+                    if (child->GetName() == L"position")
+                    {
+                        position = wxPoint(wxAtoi(child->GetAttribute(L"x", L"0")),
+                                wxAtoi(child->GetAttribute(L"y", L"0")));
+                        break;
+                    }
+                }
+
+                double scale = 1;
+                machine->GetAttribute(L"scale", L"1").ToDouble(&scale);
+                writer.AddMachine(machine->GetAttribute(L"name", L"").ToStdWstring(), position,
+                        wxAtoi(machine->GetAttribute(L"machine-number", L"1")),
+                        wxAtoi(machine->GetAttribute(L"start-frame", L"0")), scale);
+            }
+        }
+    }
+
+    return writer.Write(binaryFile);
+}
+
+/**
+ * Convert a binary animation file to XML, written
+ * the same way Picture::Save writes it
+ * @param binaryFile Binary file to read
+ * @param xmlFile XML file to write
+ * @return true if successful
+ */
+bool AnimConverter::BinaryToXml(const std::wstring& binaryFile, const std::wstring& xmlFile)
+{
+    AnimBinary file;
+    if (!file.Open(binaryFile))
+    {
+        return false;
+    }
+
+    wxXmlDocument document;
+
+    auto root = new wxXmlNode(wxXML_ELEMENT_NODE, L"anim");
+    document.SetRoot(root);
+
+    root->AddAttribute(L"title", L"Canadian Experience");
+    root->AddAttribute(L"numframes", wxString::Format(wxT("%i"), file.GetNumFrames()));
+    root->AddAttribute(L"framerate", wxString::Format(wxT("%i"), file.GetFrameRate()));
+
+    for (int i = 0; i < file.GetNumChannels(); i++)
+    {
+        auto channelNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"channel");
+        root->AddChild(channelNode);
+        channelNode->AddAttribute(L"name", file.GetChannelName(i));
+
+        auto frames = file.GetFrames(i);
+        for (int k = 0; k < file.GetNumKeyframes(i); k++)
+        {
+            auto keyframeNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
+            channelNode->AddChild(keyframeNode);
+
+            keyframeNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), frames[k]));
+            if (file.GetChannelType(i) == AnimBinary::ChannelType::Angle)
+            {
+                keyframeNode->AddAttribute(L"angle", wxString::Format(wxT("%f"), file.GetAngles(i)[k]));
+            }
+            else
+            {
+                auto points = file.GetPoints(i);
+                keyframeNode->AddAttribute(L"x", wxString::Format(wxT("%i"), points[k * 2]));
+                keyframeNode->AddAttribute(L"y", wxString::Format(wxT("%i"), points[k * 2 + 1]));
+            }
+        }
+    }
+
+    auto machinesNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"machines");
+    root->AddChild(machinesNode);
+
+    for (int i = 0; i < file.GetNumMachines(); i++)
+    {
+        auto& machine = file.GetMachine(i);
+
+        auto machineNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"machine");
+        machinesNode->AddChild(machineNode);
+        machineNode->AddAttribute(L"type", L"machine");
+        machineNode->AddAttribute(L"name", file.GetMachineName(i));
+
+        auto positionNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"position");
+        positionNode->AddAttribute(L"x", wxString::Format(L"%d", machine.mX));
+        positionNode->AddAttribute(L"y", wxString::Format(L"%d", machine.mY));
+        machineNode->AddChild(positionNode);
+
+        machineNode->AddAttribute(L"machine-number", wxString::Format(L"%d", machine.mMachineNumber));
+        machineNode->AddAttribute(L"start-frame", wxString::Format(L"%d", machine.mStartFrame));
+        machineNode->AddAttribute(L"scale", wxString::Format(L"%.2f", machine.mScale));
+    }
+
+    return document.Save(xmlFile);
+}
@@ -0,0 +1,28 @@
+/**
+ * @file AnimConverter.h
+ * @author Aditya Menon
+ *
+ * Converts animation files between the XML and binary formats
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMCONVERTER_H
+#define CANADIANEXPERIENCE_ANIMCONVERTER_H
+
+/**
+ * Converts animation files between the XML and binary formats.
+ *
+ * The conversion works on the files alone, so no picture or
+ * resources are needed. A channel's type is taken from its
+ * keyframes: angle keyframes have an angle attribute and point
+ * keyframes have x and y attributes. A channel with no keyframes
+ * is written as an angle channel, which loads the same as any
+ * other empty channel.
+ */
+class AnimConverter
+{
+public:
+    static bool XmlToBinary(const std::wstring& xmlFile, const std::wstring& binaryFile);
+    static bool BinaryToXml(const std::wstring& binaryFile, const std::wstring& xmlFile);
+};
+
+#endif //CANADIANEXPERIENCE_ANIMCONVERTER_H
@@ -0,0 +1,532 @@
+/**
+ * @file AutoSaver.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <wx/filename.h>
+#include "AutoSaver.h"
+#include "AnimBinaryWriter.h"
+#include "AnimChannelAngle.h"
+#include "AnimChannelPoint.h"
+#include "MachineAdapter.h"
+#include "Picture.h"
+#include "Timeline.h"
+
+/// Starts every journal entry, after its size
+static const uint32_t JournalMagic = 0x314a4543;   // "CEJ1"
+
+/**
+ * Append a value's bytes to a buffer
+ * @param buffer Buffer to append to
+ * @param value Value to append
+ */
+template<class T>
+static void Append(std::string& buffer, const T& value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * Append a name to a buffer as its length and UTF-8 bytes
+ * @param buffer Buffer to append to
+ * @param name Name to append
+ */
+static void AppendName(std::string& buffer, const std::wstring& name)
+{
+    auto utf8 = wxString(name).ToUTF8();
+    Append(buffer, uint32_t(utf8.length()));
+    buffer.append(utf8.data(), utf8.length());
+}
+
+/**
+ * Reads values back out of a journal entry
+ */
+class JournalReader
+{
+private:
+    const char* mData;  ///< Next byte to read
+    const char* mEnd;   ///< End of the entry
+
+public:
+    /**
+     * Constructor
+     * @param data Start of the entry
+     * @param end End of the entry
+     */
+    JournalReader(const char* data, const char* end) : mData(data), mEnd(end) {}
+
+    /**
+     * Read bytes
+     * @param dest Where to copy them to
+     * @param size Number of bytes
+     * @return false if the entry is too short
+     */
+    bool Read(void* dest, size_t size)
+    {
+        if (size > size_t(mEnd - mData))
+        {
+            return false;
+        }
+
+        memcpy(dest, mData, size);
+        mData += size;
+        return true;
+    }
+
+    /**
+     * Read a value
+     * @param value Receives the value
+     * @return false if the entry is too short
+     */
+    template<class T>
+    bool Read(T& value) { return Read(&value, sizeof(T)); }
+
+    /**
+     * Read a name written by AppendName
+     * @param name Receives the name
+     * @return false if the entry is too short
+     */
+    bool ReadName(std::wstring& name)
+    {
+        uint32_t length;
+        if (!Read(length) || length > size_t(mEnd - mData))
+        {
+            return false;
+        }
+
+        name = wxString::FromUTF8(mData, length).ToStdWstring();
+        mData += length;
+        return true;
+    }
+};
+
+/**
+ * Constructor. Any autosave left from before is removed,
+ * so recover it before starting a new AutoSaver.
+ * @param picture Picture to save
+ * @param filename Autosave file. The journal is next to it.
+ */
+AutoSaver::AutoSaver(Picture* picture, const std::wstring& filename) :
+    mPicture(picture), mFilename(filename), mJournalFilename(GetJournalFilename(filename))
+{
+    Remove(filename);
+    mWorker = std::thread(&AutoSaver::Work, this);
+}
+
+/**
+ * Destructor, writes anything saved and stops the worker
+ */
+AutoSaver::~AutoSaver()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mQueued.notify_all();
+    mWorker.join();
+}
+
+/**
+ * Copy what has changed since the last save and
+ * queue it to be written by the worker.
+ *
+ * This must be called on the thread that edits the picture.
+ */
+void AutoSaver::Save()
+{
+    auto snapshot = std::make_unique<Snapshot>();
+
+    auto timeline = mPicture->GetTimeline();
+    snapshot->mNumFrames = timeline->GetNumFrames();
+    snapshot->mFrameRate = timeline->GetFrameRate();
+
+    for (auto adapter : {mPicture->GetMachine1(), mPicture->GetMachine2()})
+    {
+        if (adapter != nullptr)
+        {
+            Machine machine;
+            machine.mName = adapter->GetName();
+            machine.mPosition = adapter->GetPosition();
+            machine.mMachineNumber = adapter->GetMachineNumber();
+            machine.mStartFrame = adapter->GetStartFrame();
+            machine.mScale = adapter->GetScale();
+            snapshot->mMachines.push_back(machine);
+        }
+    }
+
+    // Copy only the channels whose keyframes have changed
+    int numChannels = timeline->GetNumChannels();
+    int copied = (int)mRevisions.size();
+    mRevisions.resize(numChannels);
+    for (int id = 0; id < numChannels; id++)
+    {
+        auto animChannel = timeline->GetChannel(id);
+        if (id < copied && animChannel->GetRevision() == mRevisions[id])
+        {
+            continue;
+        }
+
+        Channel channel;
+        channel.mId = id;
+        channel.mName = animChannel->GetName();
+        channel.mFrames = animChannel->GetKeyframeFrames();
+        if (auto angle = dynamic_cast<AnimChannelAngle*>(animChannel))
+        {
+            channel.mType = AnimBinary::ChannelType::Angle;
+            channel.mAngles = angle->GetKeyframeAngles();
+        }
+        else if (auto point = dynamic_cast<AnimChannelPoint*>(animChannel))
+        {
+            channel.mType = AnimBinary::ChannelType::Point;
+            channel.mPoints = point->GetKeyframePoints();
+        }
+
+        mRevisions[id] = animChannel->GetRevision();
+        snapshot->mChannels.push_back(std::move(channel));
+    }
+
+    // Nothing to write if nothing has changed
+    if (snapshot->mChannels.empty() && snapshot->mNumFrames == mLast.mNumFrames &&
+        snapshot->mFrameRate == mLast.mFrameRate && snapshot->mMachines == mLast.mMachines)
+    {
+        return;
+    }
+
+    mLast.mNumFrames = snapshot->mNumFrames;
+    mLast.mFrameRate = snapshot->mFrameRate;
+    mLast.mMachines = snapshot->mMachines;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQueue.push_back(std::move(snapshot));
+    }
+    mQueued.notify_one();
+}
+
+/**
+ * Wait until everything saved so far has been written
+ */
+void AutoSaver::Flush()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdle.wait(lock, [this]() { return mQueue.empty() && !mBusy; });
+}
+
+/**
+ * The worker thread, which writes the queued snapshots
+ * until stopped and everything queued is written
+ */
+void AutoSaver::Work()
+{
+    while (true)
+    {
+        std::unique_ptr<Snapshot> snapshot;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueued.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+            if (mQueue.empty())
+            {
+                return;
+            }
+
+            snapshot = std::move(mQueue.front());
+            mQueue.pop_front();
+            mBusy = true;
+        }
+
+        Write(*snapshot);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mBusy = false;
+        }
+        mIdle.notify_all();
+    }
+}
+
+/**
+ * Apply a snapshot to the worker's copy of the animation
+ * and write it to the journal, compacting if it is time to
+ * @param snapshot Snapshot to write
+ */
+void AutoSaver::Write(const Snapshot& snapshot)
+{
+    mState.mNumFrames = snapshot.mNumFrames;
+    mState.mFrameRate = snapshot.mFrameRate;
+    mState.mMachines = snapshot.mMachines;
+    for (auto& channel : snapshot.mChannels)
+    {
+        if (channel.mId >= (int)mChannels.size())
+        {
+            mChannels.resize(channel.mId + 1);
+        }
+
+        mChannels[channel.mId] = channel;
+    }
+
+    // Until the autosave file exists, it is written in full
+    if (!mCompacted)
+    {
+        Compact();
+        return;
+    }
+
+    std::string entry;
+    Append(entry, JournalMagic);
+    Append(entry, int32_t(snapshot.mNumFrames));
+    Append(entry, int32_t(snapshot.mFrameRate));
+    Append(entry, uint32_t(snapshot.mMachines.size()));
+    Append(entry, uint32_t(snapshot.mChannels.size()));
+
+    for (auto& machine : snapshot.mMachines)
+    {
+        AppendName(entry, machine.mName);
+        Append(entry, int32_t(machine.mPosition.x));
+        Append(entry, int32_t(machine.mPosition.y));
+        Append(entry, int32_t(machine.mMachineNumber));
+        Append(entry, int32_t(machine.mStartFrame));
+        Append(entry, machine.mScale);
+    }
+
+    for (auto& channel : snapshot.mChannels)
+    {
+        AppendName(entry, channel.mName);
+        Append(entry, uint32_t(channel.mType));
+        Append(entry, uint32_t(channel.mFrames.size()));
+        for (int i = 0; i < (int)channel.mFrames.size(); i++)
+        {
+            Append(entry, int32_t(channel.mFrames[i]));
+            if (channel.mType == AnimBinary::ChannelType::Angle)
+            {
+                Append(entry, channel.mAngles[i]);
+            }
+            else
+            {
+                Append(entry, int32_t(channel.mPoints[i].x));
+                Append(entry, int32_t(channel.mPoints[i].y));
+            }
+        }
+    }
+
+    // The size goes first, so an entry cut short by a
+    // crash is recognized and ignored by Recover
+    std::ofstream journal(wxString(mJournalFilename).fn_str(), std::ios::binary | std::ios::app);
+    uint64_t size = entry.size();
+    journal.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    journal.write(entry.data(), entry.size());
+    journal.flush();
+
+    mChannelsWritten += (int)snapshot.mChannels.size();
+    mJournalSize += sizeof(size) + entry.size();
+    mEntries++;
+
+    if (mEntries >= CompactEntries || mJournalSize >= CompactSize)
+    {
+        Compact();
+    }
+}
+
+/**
+ * Write the whole animation to the autosave file and empty the journal
+ */
+void AutoSaver::Compact()
+{
+    AnimBinaryWriter writer;
+    writer.SetTimeline(mState.mNumFrames, mState.mFrameRate);
+    for (auto& channel : mChannels)
+    {
+        if (channel.mType == AnimBinary::ChannelType::Angle)
+        {
+            writer.AddAngleChannel(channel.mName, channel.mFrames, channel.mAngles);
+        }
+        else
+        {
+            writer.AddPointChannel(channel.mName, channel.mFrames, channel.mPoints);
+        }
+    }
+
+    for (auto& machine : mState.mMachines)
+    {
+        writer.AddMachine(machine.mName, machine.mPosition, machine.mMachineNumber,
+                machine.mStartFrame, machine.mScale);
+    }
+
+    // Write a new file and rename it over the old one, so
+    // there is always a complete autosave file
+    auto temp = mFilename + L".tmp";
+    if (!writer.Write(temp) || !wxRenameFile(temp, mFilename, true))
+    {
+        return;
+    }
+
+    std::ofstream journal(wxString(mJournalFilename).fn_str(), std::ios::binary | std::ios::trunc);
+    mCompacted = true;
+    mEntries = 0;
+    mJournalSize = 0;
+}
+
+/**
+ * Apply one journal entry to a picture
+ * @param picture Picture to apply it to
+ * @param reader Reader for the entry
+ * @return false if the entry is not valid
+ */
+static bool ReplayEntry(Picture* picture, JournalReader& reader)
+{
+    uint32_t magic, numMachines, numChannels;
+    int32_t numFrames, frameRate;
+    if (!reader.Read(magic) || magic != JournalMagic ||
+        !reader.Read(numFrames) || !reader.Read(frameRate) ||
+        !reader.Read(numMachines) || !reader.Read(numChannels))
+    {
+        return false;
+    }
+
+    auto timeline = picture->GetTimeline();
+    timeline->SetNumFrames(numFrames);
+    timeline->SetFrameRate(frameRate);
+
+    for (uint32_t i = 0; i < numMachines; i++)
+    {
+        std::wstring name;
+        int32_t x, y, machineNumber, startFrame;
+        double scale;
+        if (!reader.ReadName(name) || !reader.Read(x) || !reader.Read(y) ||
+            !reader.Read(machineNumber) || !reader.Read(startFrame) || !reader.Read(scale))
+        {
+            return false;
+        }
+
+        auto machine = picture->GetMachine(name);
+        if (machine != nullptr)
+        {
+            machine->SetPosition(wxPoint(x, y));
+            machine->SetMachineNumber(machineNumber);
+            machine->SetStartFrame(startFrame);
+            machine->SetScale(scale);
+        }
+    }
+
+    for (uint32_t i = 0; i < numChannels; i++)
+    {
+        std::wstring name;
+        uint32_t type, count;
+        if (!reader.ReadName(name) || !reader.Read(type) || !reader.Read(count))
+        {
+            return false;
+        }
+
+        bool isAngle = type == uint32_t(AnimBinary::ChannelType::Angle);
+        std::vector<int32_t> frames(count);
+        std::vector<double> angles(isAngle ? count : 0);
+        std::vector<int32_t> points(isAngle ? 0 : count * 2);
+        for (uint32_t k = 0; k < count; k++)
+        {
+            bool ok = reader.Read(frames[k]) && (isAngle ? reader.Read(angles[k]) :
+                    reader.Read(points[k * 2]) && reader.Read(points[k * 2 + 1]));
+            if (!ok)
+            {
+                return false;
+            }
+        }
+
+        int id = timeline->FindChannel(name);
+        if (id == Timeline::NoChannel)
+        {
+            continue;
+        }
+
+        auto channel = timeline->GetChannel(id);
+        if (isAngle)
+        {
+            if (auto angle = dynamic_cast<AnimChannelAngle*>(channel))
+            {
+                angle->SetKeyframes(frames.data(), angles.data(), (int)count);
+            }
+        }
+        else if (auto point = dynamic_cast<AnimChannelPoint*>(channel))
+        {
+            point->SetKeyframes(frames.data(), points.data(), (int)count);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Load an autosaved animation into a picture
+ * @param picture Picture to load into
+ * @param filename Autosave file
+ * @return true if there was an autosave to recover
+ */
+bool AutoSaver::Recover(Picture* picture, const std::wstring& filename)
+{
+    auto journalFilename = GetJournalFilename(filename);
+    bool hasFile = wxFileExists(filename);
+    if (!hasFile && !wxFileExists(journalFilename))
+    {
+        return false;
+    }
+
+    if (hasFile)
+    {
+        picture->Load(filename);
+    }
+    else
+    {
+        picture->GetTimeline()->Clear();
+    }
+
+    std::ifstream journal(wxString(journalFilename).fn_str(), std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(journal)), std::istreambuf_iterator<char>());
+
+    // Each entry holds the whole of its channels, so
+    // replaying them in order gives the latest keyframes
+    const char* p = data.data();
+    const char* end = p + data.size();
+    while (true)
+    {
+        uint64_t size;
+        if (size_t(end - p) < sizeof(size))
+        {
+            break;
+        }
+
+        memcpy(&size, p, sizeof(size));
+        p += sizeof(size);
+        if (size > uint64_t(end - p))
+        {
+            // Cut short by a crash while it was written
+            break;
+        }
+
+        JournalReader reader(p, p + size);
+        p += size;
+        if (!ReplayEntry(picture, reader))
+        {
+            break;
+        }
+    }
+
+    picture->SetAnimationTime(0);
+    return true;
+}
+
+/**
+ * Remove an autosave file and its journal
+ * @param filename Autosave file
+ */
+void AutoSaver::Remove(const std::wstring& filename)
+{
+    for (auto file : {filename, GetJournalFilename(filename), filename + L".tmp"})
+    {
+        if (wxFileExists(file))
+        {
+            wxRemoveFile(file);
+        }
+    }
+}
@@ -0,0 +1,182 @@
+/**
+ * @file AutoSaver.h
+ * @author Aditya Menon
+ *
+ * Saves the animation in the background as it is edited
+ */
+
+#ifndef CANADIANEXPERIENCE_AUTOSAVER_H
+#define CANADIANEXPERIENCE_AUTOSAVER_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AnimBinary.h"
+
+class Picture;
+
+/**
+ * Saves the animation in the background as it is edited.
+ *
+ * Save is called on the UI thread, typically from a timer. It
+ * copies only the channels whose keyframes have changed since the
+ * last call, which it knows from each channel's revision, and
+ * hands the copy to a worker thread. Channels that have not
+ * changed are never copied again, so a save takes time in
+ * proportion to the edits rather than to the animation.
+ *
+ * The worker appends the changed channels to a journal file.
+ * Every CompactEntries entries, or once the journal reaches
+ * CompactSize bytes, it compacts: it writes the whole animation
+ * from its own copy to the autosave file in the binary animation
+ * format and empties the journal. The autosave file is replaced
+ * by renaming a new one over it, and each journal entry holds
+ * the complete keyframes of its channels, so a crash at any point
+ * leaves a file and journal that Recover can read.
+ */
+class AutoSaver
+{
+public:
+    /// Number of journal entries that causes a compaction
+    static const int CompactEntries = 64;
+
+    /// Journal size in bytes that causes a compaction
+    static const size_t CompactSize = 16 * 1024 * 1024;
+
+private:
+    /// A copy of the keyframes of one channel
+    struct Channel
+    {
+        int mId = -1;                       ///< Channel ID in the timeline
+        std::wstring mName;                 ///< Channel name
+        AnimBinary::ChannelType mType = AnimBinary::ChannelType::Angle;    ///< Channel type
+        std::vector<int> mFrames;           ///< Keyframe frames
+        std::vector<double> mAngles;        ///< Keyframe angles of an angle channel
+        std::vector<wxPoint> mPoints;       ///< Keyframe points of a point channel
+    };
+
+    /// A copy of the settings of one machine
+    struct Machine
+    {
+        std::wstring mName;                 ///< Machine name
+        wxPoint mPosition;                  ///< Machine position
+        int mMachineNumber = 1;             ///< Machine number
+        int mStartFrame = 0;                ///< Frame the machine starts on
+        double mScale = 1;                  ///< Drawing scale
+
+        /**
+         * Compare machine settings
+         * @param other Settings to compare to
+         * @return true if the settings are the same
+         */
+        bool operator==(const Machine& other) const
+        {
+            return mName == other.mName && mPosition == other.mPosition &&
+                   mMachineNumber == other.mMachineNumber &&
+                   mStartFrame == other.mStartFrame && mScale == other.mScale;
+        }
+    };
+
+    /// What one call to Save copied
+    struct Snapshot
+    {
+        int mNumFrames = 0;                 ///< Timeline number of frames
+        int mFrameRate = 0;                 ///< Timeline frame rate
+        std::vector<Machine> mMachines;     ///< Every machine
+        std::vector<Channel> mChannels;     ///< The changed channels
+    };
+
+    /// The picture being saved
+    Picture* mPicture;
+
+    /// The autosave file
+    std::wstring mFilename;
+
+    /// The journal file
+    std::wstring mJournalFilename;
+
+    /// Revision of each channel when it was last copied, by channel ID
+    std::vector<unsigned> mRevisions;
+
+    /// The settings in the last snapshot
+    Snapshot mLast;
+
+    /// Snapshots waiting for the worker
+    std::deque<std::unique_ptr<Snapshot>> mQueue;
+
+    /// True while the worker is writing a snapshot
+    bool mBusy = false;
+
+    /// True when the worker should exit
+    bool mStop = false;
+
+    /// Protects mQueue, mBusy and mStop
+    std::mutex mMutex;
+
+    /// Signalled when a snapshot is queued or the worker should stop
+    std::condition_variable mQueued;
+
+    /// Signalled when the worker has written everything queued
+    std::condition_variable mIdle;
+
+    /// The worker's copy of the whole animation, by channel ID
+    std::vector<Channel> mChannels;
+
+    /// The worker's copy of the timeline settings and machines
+    Snapshot mState;
+
+    /// Journal entries since the last compaction
+    int mEntries = 0;
+
+    /// Journal size in bytes
+    size_t mJournalSize = 0;
+
+    /// True once the autosave file has been written
+    bool mCompacted = false;
+
+    /// Number of channels written to the journal, for testing
+    int mChannelsWritten = 0;
+
+    /// The worker thread
+    std::thread mWorker;
+
+    void Work();
+    void Write(const Snapshot& snapshot);
+    void Compact();
+
+public:
+    AutoSaver(Picture* picture, const std::wstring& filename);
+    ~AutoSaver();
+
+    /// Copy constructor (disabled)
+    AutoSaver(const AutoSaver &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const AutoSaver &) = delete;
+
+    void Save();
+    void Flush();
+
+    /**
+     * Get the number of channels written to the journal. Only
+     * meaningful after Flush.
+     * @return Number of channels
+     */
+    int GetChannelsWritten() const { return mChannelsWritten; }
+
+    /**
+     * Get the journal file that goes with an autosave file
+     * @param filename Autosave file
+     * @return Journal file
+     */
+    static std::wstring GetJournalFilename(const std::wstring& filename) { return filename + L".journal"; }
+
+    static bool Recover(Picture* picture, const std::wstring& filename);
+    static void Remove(const std::wstring& filename);
+};
+
+#endif //CANADIANEXPERIENCE_AUTOSAVER_H
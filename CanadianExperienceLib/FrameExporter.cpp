@@ -0,0 +1,221 @@
+/**
+ * @file FrameExporter.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <wx/filename.h>
+#include <wx/stopwatch.h>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <tracer.h>
+
+#include "FrameExporter.h"
+#include "Picture.h"
+#include "Timeline.h"
+
+/**
+ * Constructor
+ * @param picture Picture to render, with its animation loaded
+ */
+FrameExporter::FrameExporter(std::shared_ptr<Picture> picture) : mPicture(picture)
+{
+}
+
+/**
+ * Get the last frame Export will render
+ * @return Last frame number
+ */
+int FrameExporter::GetLastFrame() const
+{
+    if (mLastFrame >= 0)
+    {
+        return mLastFrame;
+    }
+
+    return mPicture->GetTimeline()->GetNumFrames() - 1;
+}
+
+/**
+ * Draw one frame of the animation into an image
+ * @param frame Frame number
+ * @param image Image to draw into, resized to the picture size
+ */
+void FrameExporter::RenderFrame(int frame, wxImage& image)
+{
+    Tracer::Scope trace("FrameExporter::RenderFrame", "frame", frame);
+
+    auto frameRate = mPicture->GetTimeline()->GetFrameRate();
+    mPicture->SetAnimationTime(double(frame) / frameRate);
+
+    auto size = mPicture->GetSize();
+    if (!image.IsOk() || image.GetWidth() != size.GetWidth() || image.GetHeight() != size.GetHeight())
+    {
+        image.Create(size.GetWidth(), size.GetHeight(), false);
+    }
+
+    // White background, the same as the edit view
+    image.Clear(255);
+
+    // The context writes the drawing back into the image when it is destroyed
+    {
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+        mPicture->Draw(graphics);
+    }
+}
+
+/**
+ * Write a rendered frame to the output directory
+ * @param frame Frame number
+ * @param image Rendered image
+ * @return true if the file was written
+ */
+bool FrameExporter::WriteFrame(int frame, const wxImage& image)
+{
+    auto filename = GetFrameFilename(frame);
+
+    if (mFormat == Format::PNG)
+    {
+        return image.SaveFile(filename, wxBITMAP_TYPE_PNG);
+    }
+
+    // Raw RGBA, filling in opaque alpha if the image has none
+    int count = image.GetWidth() * image.GetHeight();
+    const unsigned char* rgb = image.GetData();
+    const unsigned char* alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+
+    std::vector<unsigned char> pixels(size_t(count) * 4);
+    for (int i = 0; i < count; i++)
+    {
+        pixels[i * 4] = rgb[i * 3];
+        pixels[i * 4 + 1] = rgb[i * 3 + 1];
+        pixels[i * 4 + 2] = rgb[i * 3 + 2];
+        pixels[i * 4 + 3] = alpha != nullptr ? alpha[i] : 255;
+    }
+
+    std::ofstream file(wxString(filename).fn_str(), std::ios::binary);
+    file.write((const char*)pixels.data(), pixels.size());
+    return file.good();
+}
+
+/**
+ * Get the file name for a frame
+ * @param frame Frame number
+ * @return Full path of the frame file
+ */
+std::wstring FrameExporter::GetFrameFilename(int frame) const
+{
+    auto name = wxString::Format(L"frame%05d.%s", frame, mFormat == Format::PNG ? L"png" : L"rgba");
+    return wxFileName(mOutputDir, name).GetFullPath().ToStdWstring();
+}
+
+/**
+ * Render and write every frame in the frame range
+ * @return true if every frame was written
+ */
+bool FrameExporter::Export()
+{
+    mFramesWritten = 0;
+
+    wxStopWatch stopWatch;
+
+    int first = mFirstFrame;
+    int last = GetLastFrame();
+    int threads = std::min(mThreads, last - first + 1);
+
+    bool ok;
+    if (threads > 1 && mPictureFactory != nullptr)
+    {
+        ok = ExportParallel(first, last, threads);
+    }
+    else
+    {
+        ok = ExportRange(first, last);
+    }
+
+    mElapsed = stopWatch.Time() / 1000.0;
+    return ok;
+}
+
+/**
+ * Render and write a range of frames with this exporter's picture
+ * @param first First frame
+ * @param last Last frame
+ * @return true if every frame was written
+ */
+bool FrameExporter::ExportRange(int first, int last)
+{
+    // Every frame reads its channel values from the samples. Only
+    // this range is baked, since parallel workers each have a range.
+    mPicture->GetTimeline()->Bake(first, last);
+
+    wxImage image;
+    for (int frame = first; frame <= last; frame++)
+    {
+        RenderFrame(frame, image);
+        if (!WriteFrame(frame, image))
+        {
+            return false;
+        }
+
+        mFramesWritten++;
+    }
+
+    return true;
+}
+
+/**
+ * Render and write a range of frames on several threads
+ *
+ * The worker pictures are all created here, before any thread
+ * starts, so only drawing and file writing happen on the workers.
+ * Our own picture is not used, since it may share graphics
+ * bitmaps with windows on the main thread.
+ *
+ * @param first First frame
+ * @param last Last frame
+ * @param threads Number of threads
+ * @return true if every frame was written
+ */
+bool FrameExporter::ExportParallel(int first, int last, int threads)
+{
+    std::vector<std::unique_ptr<FrameExporter>> workers;
+    for (int i = 0; i < threads; i++)
+    {
+        // The frames are already split between threads, so each
+        // worker evaluates its own animation channels on its own
+        auto picture = mPictureFactory();
+        picture->GetTimeline()->SetThreads(1);
+
+        auto worker = std::make_unique<FrameExporter>(picture);
+        worker->SetOutputDir(mOutputDir);
+        worker->SetFormat(mFormat);
+        workers.push_back(std::move(worker));
+    }
+
+    // Contiguous blocks, so each worker steps its
+    // machines forward frame by frame
+    int count = last - first + 1;
+    std::vector<char> results(threads, false);
+    std::vector<std::thread> running;
+    for (int i = 0; i < threads; i++)
+    {
+        int blockFirst = first + int((long long)count * i / threads);
+        int blockLast = first + int((long long)count * (i + 1) / threads) - 1;
+        running.emplace_back([&workers, &results, i, blockFirst, blockLast]() {
+            results[i] = workers[i]->ExportRange(blockFirst, blockLast);
+        });
+    }
+
+    bool ok = true;
+    for (int i = 0; i < threads; i++)
+    {
+        running[i].join();
+        mFramesWritten += workers[i]->GetFramesWritten();
+        ok = ok && results[i];
+    }
+
+    return ok;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file FrameExporter.h
+ * @author Aditya Menon
+ *
+ * Renders the frames of an animation to image files without a window
+ */
+
+#ifndef CANADIANEXPERIENCE_FRAMEEXPORTER_H
+#define CANADIANEXPERIENCE_FRAMEEXPORTER_H
+
+#include <functional>
+
+class Picture;
+
+/**
+ * Renders the frames of an animation to image files without a window.
+ *
+ * Each frame is drawn with a wxGraphicsContext that renders
+ * straight into a wxImage, so no display is needed, and the
+ * frames are produced as fast as they can be drawn rather than
+ * at the animation frame rate.
+ *
+ * With more than one thread, the frame range is split into
+ * contiguous blocks, one per worker. Every worker has its own
+ * Picture, made by the picture factory, so it has its own actors,
+ * timeline and machines. Everything drawn is a function of the
+ * frame number, so the files are identical to a single-threaded
+ * export.
+ *
+ * The timeline is baked before the first frame, so the
+ * animation channels are read from their samples rather
+ * than tweened for every frame.
+ */
+class FrameExporter
+{
+public:
+    /// Output file formats
+    enum class Format {
+        PNG,    ///< One PNG file per frame
+        RGBA    ///< Raw 8 bit RGBA pixels, one file per frame, no header
+    };
+
+private:
+    /// The picture we render
+    std::shared_ptr<Picture> mPicture;
+
+    /// Directory the frame files are written to
+    std::wstring mOutputDir;
+
+    /// Output file format
+    Format mFormat = Format::PNG;
+
+    /// First frame to render
+    int mFirstFrame = 0;
+
+    /// Last frame to render, or -1 for the last frame of the animation
+    int mLastFrame = -1;
+
+    /// Number of frames written by the last Export
+    int mFramesWritten = 0;
+
+    /// Time the last Export took in seconds
+    double mElapsed = 0;
+
+    /// Number of threads to render with
+    int mThreads = 1;
+
+    /// Creates an independent copy of the picture for each worker
+    std::function<std::shared_ptr<Picture>()> mPictureFactory;
+
+    /**
+     * Render and write a range of frames with this exporter's picture
+     * @param first First frame
+     * @param last Last frame
+     * @return true if every frame was written
+     */
+    bool ExportRange(int first, int last);
+
+    /**
+     * Render and write a range of frames on several threads
+     * @param first First frame
+     * @param last Last frame
+     * @param threads Number of threads
+     * @return true if every frame was written
+     */
+    bool ExportParallel(int first, int last, int threads);
+
+public:
+    /// Default constructor (disabled)
+    FrameExporter() = delete;
+
+    /**
+     * Constructor
+     * @param picture Picture to render, with its animation loaded
+     */
+    FrameExporter(std::shared_ptr<Picture> picture);
+
+    /**
+     * Draw one frame of the animation into an image
+     * @param frame Frame number
+     * @param image Image to draw into, resized to the picture size
+     */
+    void RenderFrame(int frame, wxImage& image);
+
+    /**
+     * Write a rendered frame to the output directory
+     * @param frame Frame number
+     * @param image Rendered image
+     * @return true if the file was written
+     */
+    bool WriteFrame(int frame, const wxImage& image);
+
+    /**
+     * Render and write every frame in the frame range
+     * @return true if every frame was written
+     */
+    bool Export();
+
+    /**
+     * Get the file name for a frame
+     * @param frame Frame number
+     * @return Full path of the frame file
+     */
+    std::wstring GetFrameFilename(int frame) const;
+
+    /**
+     * Set the directory the frame files are written to
+     * @param dir Output directory
+     */
+    void SetOutputDir(const std::wstring& dir) { mOutputDir = dir; }
+
+    /**
+     * Set the output file format
+     * @param format File format
+     */
+    void SetFormat(Format format) { mFormat = format; }
+
+    /**
+     * Set the range of frames to render
+     * @param first First frame
+     * @param last Last frame, or -1 for the last frame of the animation
+     */
+    void SetFrameRange(int first, int last) { mFirstFrame = first; mLastFrame = last; }
+
+    /**
+     * Set the number of threads Export renders with
+     *
+     * More than one thread requires a picture factory.
+     * @param threads Number of threads
+     */
+    void SetThreads(int threads) { mThreads = threads; }
+
+    /**
+     * Get the number of threads Export renders with
+     * @return Number of threads
+     */
+    int GetThreads() const { return mThreads; }
+
+    /**
+     * Set the function that creates a picture for each worker
+     *
+     * The function is called on the thread that calls Export. It
+     * must return a new picture with the same animation loaded.
+     * @param factory Picture factory function
+     */
+    void SetPictureFactory(std::function<std::shared_ptr<Picture>()> factory) { mPictureFactory = factory; }
+
+    /**
+     * Get the first frame Export will render
+     * @return First frame number
+     */
+    int GetFirstFrame() const { return mFirstFrame; }
+
+    /**
+     * Get the last frame Export will render
+     * @return Last frame number
+     */
+    int GetLastFrame() const;
+
+    /**
+     * Get the number of frames written by the last Export
+     * @return Number of frames
+     */
+    int GetFramesWritten() const { return mFramesWritten; }
+
+    /**
+     * Get the time the last Export took
+     * @return Time in seconds
+     */
+    double GetElapsed() const { return mElapsed; }
+};
+
+#endif //CANADIANEXPERIENCE_FRAMEEXPORTER_H
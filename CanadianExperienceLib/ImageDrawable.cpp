@@ -5,6 +5,8 @@
 
 #include "pch.h"
 #include "ImageDrawable.h"
+#include <image-cache.h>
+#include <graphics-resource-cache.h>
 
 
 /** Constructor
@@ -13,7 +15,7 @@
 ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filename) :
         Drawable(name)
 {
-    mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
+    mImage = ImageCache::Get().GetImage(filename);
 }
 
 
@@ -23,15 +25,15 @@ ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filen
  */
 void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    if(mBitmap.IsNull())
+    if(mImage == nullptr)
     {
-        mBitmap = graphics->CreateBitmapFromImage(*mImage);
+        return;
     }
 
     graphics->PushState();
     graphics->Translate(mPlacedPosition.x, mPlacedPosition.y);
     graphics->Rotate(-mPlacedR);
-    graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
+    graphics->DrawBitmap(GraphicsResourceCache::Get().GetBitmap(graphics, mImage), -mCenter.x, -mCenter.y,
             mImage->GetWidth(), mImage->GetHeight());
 
     graphics->PopState();
@@ -45,6 +47,11 @@ void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  */
 bool ImageDrawable::HitTest(wxPoint pos)
 {
+    if(mImage == nullptr)
+    {
+        return false;
+    }
+
     double x = pos.x;
     double y = pos.y;
 
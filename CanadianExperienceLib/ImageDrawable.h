@@ -15,11 +15,8 @@
  */
 class ImageDrawable : public Drawable {
 private:
-    /// The underlying image we are drawing
-    std::unique_ptr<wxImage> mImage;
-
-    /// The graphics bitmap we will use
-    wxGraphicsBitmap mBitmap;
+    /// The underlying image we are drawing, shared through the image cache
+    std::shared_ptr<const wxImage> mImage;
 
     /// The center of the image
     wxPoint mCenter = wxPoint(0, 0);
@@ -4,7 +4,9 @@
  */
 
 #include "pch.h"
+#include <tracer.h>
 #include "MachineAdapter.h"
+#include "XmlStreamReader.h"
 
 using namespace std;
 
@@ -28,6 +30,8 @@ MachineAdapter::MachineAdapter(const std::wstring& resourcesDir, const std::wstr
  */
 void MachineAdapter::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    Tracer::Scope trace("MachineAdapter::Draw", "machine", mMachineNumber);
+
     // Save the current state
     graphics->PushState();
 
@@ -97,18 +101,11 @@ void MachineAdapter::SetMachineNumber(int machineNumber)
 {
     mMachineNumber = machineNumber;
 
-    // IMachineSystem doesn't have SetMachineNumber, so we need to
-    // recreate the machine with the new number
-    MachineSystemFactory factory(mResourcesDir);
-    mMachine = factory.CreateMachineSystem();
+    // Choose the machine directly. This creates no windows, so
+    // pictures can be built headless and for render workers.
+    mMachine->ChooseMachine(machineNumber);
     mMachine->SetMachineFrame(0);  // Reset to frame 0
-
-    // Try to set machine number indirectly through configuration
-    // This assumes MachineDialog sets the number internally
-    wxWindow* parent = nullptr;  // We don't have a parent window here
-    MachineDialog dialog(parent, mMachine);
-    // Set machine number (not directly possible, dialog may provide this)
-    dialog.Destroy();  // Don't show the dialog, just use it to configure
+    mRunning = false;
 }
 
 /**
@@ -121,8 +118,8 @@ bool MachineAdapter::ShowDialog(wxWindow* parent)
     MachineDialog dialog(parent, mMachine);
     if (dialog.ShowModal() == wxID_OK)
     {
-        // We can't directly get the machine number, so just store our value
-        // The dialog should have configured the machine internally
+        // The dialog chose the machine, keep our number in step with it
+        mMachineNumber = mMachine->GetMachineNumber();
         return true;
     }
 
@@ -152,33 +149,25 @@ void MachineAdapter::XmlSave(wxXmlNode* node)
 }
 
 /**
- * Load this drawable from an XML node
- * @param node Node to load from
+ * Load this drawable from an element read by the streaming loader.
+ *
+ * The machine element holds the machine number, start frame and
+ * scale. The position element within it holds the position.
+ * @param element The machine element or an element within it
  */
-void MachineAdapter::XmlLoad(wxXmlNode* node)
+void MachineAdapter::XmlStreamStart(const XmlStreamElement& element)
 {
-    // Load position
-    wxXmlNode* positionNode = node->GetChildren();
-    while (positionNode != nullptr)
+    auto name = element.GetName();
+    if (name == "machine")
     {
-        if (positionNode->GetName() == L"position")
-        {
-            int x = wxAtoi(positionNode->GetAttribute(L"x", L"0"));
-            int y = wxAtoi(positionNode->GetAttribute(L"y", L"0"));
-            SetPosition(wxPoint(x, y));
-            break;
-        }
+        SetMachineNumber(element.GetAttributeInt("machine-number", 1));
+        mStartFrame = element.GetAttributeInt("start-frame", 0);
 
-        positionNode = positionNode->GetNext();
+        // Keep the current scale if none is present
+        mScale = element.GetAttributeDouble("scale", mScale);
+    }
+    else if (name == "position")
+    {
+        SetPosition(wxPoint(element.GetAttributeInt("x", 0), element.GetAttributeInt("y", 0)));
     }
-
-    // Load the machine number
-    int machineNumber = wxAtoi(node->GetAttribute(L"machine-number", L"1"));
-    SetMachineNumber(machineNumber);
-
-    // Load the start frame
-    mStartFrame = wxAtoi(node->GetAttribute(L"start-frame", L"0"));
-
-    // Load the scale if present
-    node->GetAttribute(L"scale", wxString::Format(L"%.2f", mScale)).ToDouble(&mScale);
 }
\ No newline at end of file
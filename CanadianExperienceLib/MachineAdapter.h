@@ -11,6 +11,8 @@
 #include "Drawable.h"
 #include <machine-api.h>
 
+class XmlStreamElement;
+
 /**
  * Class that adapts the IMachineSystem to be a Drawable for
  * the Canadian Experience
@@ -116,10 +118,10 @@ public:
     virtual void XmlSave(wxXmlNode* node);
 
     /**
-     * Load this drawable from an XML node
-     * @param node Node to load from
+     * Load this drawable from an element read by the streaming loader
+     * @param element The machine element or an element within it
      */
-    virtual void XmlLoad(wxXmlNode* node);
+    void XmlStreamStart(const XmlStreamElement& element);
 };
 
 #endif //CANADIANEXPERIENCE_MACHINEADAPTER_H
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include <wx/xrc/xmlres.h>
 #include <wx/stdpaths.h>
+#include <wx/filename.h>
 
 #include "MainFrame.h"
 
@@ -15,6 +16,7 @@
 #include "PictureFactory.h"
 #include "MachineAdapter.h"
 #include "MachinePropertiesDialog.h"
+#include "AutoSaver.h"
 
 /// Directory within resources that contains the images.
 const std::wstring ImagesDirectory = L"/images";
@@ -25,6 +27,12 @@ const int ID_MACHINE1_SELECT = wxID_HIGHEST + 301;
 const int ID_MACHINE2_PROPERTIES = wxID_HIGHEST + 302;
 const int ID_MACHINE2_SELECT = wxID_HIGHEST + 303;
 
+/// The autosave file within the user data directory
+const std::wstring AutoSaveFilename = L"/autosave.anim";
+
+/// Time between autosaves in milliseconds
+const int AutoSaveInterval = 30000;
+
 /**
  * Constructor
  * @param resourcesDir Directory path containing resources
@@ -35,6 +43,13 @@ MainFrame::MainFrame(std::wstring resourcesDir) :
 
 }
 
+/**
+ * Destructor. Defined here, where AutoSaver is a complete type.
+ */
+MainFrame::~MainFrame()
+{
+}
+
 
 
 /**
@@ -90,6 +105,52 @@ void MainFrame::Initialize()
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnMachine1Select, this, ID_MACHINE1_SELECT);
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnMachine2Properties, this, ID_MACHINE2_PROPERTIES);
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnMachine2Select, this, ID_MACHINE2_SELECT);
+
+    StartAutoSave();
+}
+
+/**
+ * Start saving the animation in the background.
+ *
+ * If the program did not exit cleanly last time, the autosave
+ * file is still there, and the user is offered the animation
+ * it holds before it is replaced.
+ */
+void MainFrame::StartAutoSave()
+{
+    auto dir = wxStandardPaths::Get().GetUserDataDir();
+    if (!wxFileName::DirExists(dir) && !wxFileName::Mkdir(dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+    {
+        return;
+    }
+
+    auto filename = dir.ToStdWstring() + AutoSaveFilename;
+    if (wxFileExists(filename) || wxFileExists(AutoSaver::GetJournalFilename(filename)))
+    {
+        if (wxMessageBox(L"The animation was not saved when the program last exited. Recover it?",
+                L"Recover Animation", wxYES_NO | wxICON_QUESTION, this) == wxYES)
+        {
+            AutoSaver::Recover(mPicture.get(), filename);
+        }
+    }
+
+    // Creating the autosaver removes the old autosave file,
+    // so save whatever was recovered right away
+    mAutoSaver = std::make_unique<AutoSaver>(mPicture.get(), filename);
+    mAutoSaver->Save();
+
+    mAutoSaveTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &MainFrame::OnAutoSaveTimer, this, mAutoSaveTimer.GetId());
+    mAutoSaveTimer.Start(AutoSaveInterval);
+}
+
+/**
+ * Handle the autosave timer
+ * @param event Timer event
+ */
+void MainFrame::OnAutoSaveTimer(wxTimerEvent& event)
+{
+    mAutoSaver->Save();
 }
 
 
@@ -122,6 +183,16 @@ void MainFrame::OnAbout(wxCommandEvent& event)
 void MainFrame::OnClose(wxCloseEvent& event)
 {
     mViewTimeline->Stop();
+
+    // Let the autosave finish, then remove it, since
+    // there is nothing to recover after a clean exit
+    mAutoSaveTimer.Stop();
+    if (mAutoSaver != nullptr)
+    {
+        mAutoSaver.reset();
+        AutoSaver::Remove((wxStandardPaths::Get().GetUserDataDir() + AutoSaveFilename).ToStdWstring());
+    }
+
     Destroy();
 }
 
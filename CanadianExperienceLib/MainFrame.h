@@ -10,6 +10,7 @@
 class ViewEdit;
 class ViewTimeline;
 class Picture;
+class AutoSaver;
 
 /**
  * The top-level (main) frame of the application
@@ -35,6 +36,12 @@ private:
     /// Is the animation currently playing?
     bool mPlaying = false;
 
+    /// Saves the animation in the background as it is edited
+    std::unique_ptr<AutoSaver> mAutoSaver;
+
+    /// The autosave timer
+    wxTimer mAutoSaveTimer;
+
     void OnExit(wxCommandEvent& event);
     void OnAbout(wxCommandEvent& event);
     void OnClose(wxCloseEvent& event);
@@ -49,6 +56,7 @@ private:
     void OnSetAnimationSpeed(wxCommandEvent& event);
     void OnSetAnimationStop(wxCommandEvent& event);
     void OnTimer(wxTimerEvent& event);
+    void OnAutoSaveTimer(wxTimerEvent& event);
     
     // Machine menu handlers
     void OnMachine1Properties(wxCommandEvent& event);
@@ -61,8 +69,12 @@ private:
 
 public:
     MainFrame(std::wstring resourcesDir);
+    virtual ~MainFrame();
 
     void Initialize();
+
+private:
+    void StartAutoSave();
 };
 
 #endif //_MAINFRAME_H_
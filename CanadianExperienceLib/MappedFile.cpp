@@ -0,0 +1,122 @@
+/**
+ * @file MappedFile.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef WIN32
+#include <wx/msw/wrapwin.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Destructor, unmaps any open file
+ */
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+/**
+ * Map a file into memory, closing any file already open
+ * @param filename File to map
+ * @return true if the file was mapped. An empty file can not be mapped.
+ */
+bool MappedFile::Open(const std::wstring& filename)
+{
+    Close();
+
+#ifdef WIN32
+    auto file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFile = file;
+    mMapping = mapping;
+    mData = static_cast<const char*>(data);
+    mSize = size_t(size.QuadPart);
+#else
+    int file = open(wxString(filename).fn_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    auto data = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED)
+    {
+        close(file);
+        return false;
+    }
+
+    mFile = file;
+    mData = static_cast<const char*>(data);
+    mSize = size_t(info.st_size);
+#endif
+
+    return true;
+}
+
+/**
+ * Unmap the file. Pointers into the data are no longer valid.
+ */
+void MappedFile::Close()
+{
+    if (mData == nullptr)
+    {
+        return;
+    }
+
+#ifdef WIN32
+    UnmapViewOfFile(mData);
+    CloseHandle(mMapping);
+    CloseHandle(mFile);
+    mMapping = nullptr;
+    mFile = nullptr;
+#else
+    munmap(const_cast<char*>(mData), mSize);
+    close(mFile);
+    mFile = -1;
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file MappedFile.h
+ * @author Aditya Menon
+ *
+ * A file mapped read-only into memory
+ */
+
+#ifndef CANADIANEXPERIENCE_MAPPEDFILE_H
+#define CANADIANEXPERIENCE_MAPPEDFILE_H
+
+#include <string>
+
+/**
+ * A file mapped read-only into memory.
+ *
+ * The operating system pages the contents in as they are read,
+ * so opening even a very large file is immediate and nothing is
+ * copied. The data stays valid until Close or destruction.
+ */
+class MappedFile
+{
+private:
+    /// The mapped contents or nullptr if no file is open
+    const char* mData = nullptr;
+
+    /// Size of the file in bytes
+    size_t mSize = 0;
+
+#ifdef WIN32
+    /// The open file handle
+    void* mFile = nullptr;
+
+    /// The file mapping handle
+    void* mMapping = nullptr;
+#else
+    /// The open file descriptor
+    int mFile = -1;
+#endif
+
+public:
+    MappedFile() {}
+    ~MappedFile();
+
+    /// Copy constructor (disabled)
+    MappedFile(const MappedFile &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MappedFile &) = delete;
+
+    bool Open(const std::wstring& filename);
+    void Close();
+
+    /**
+     * Get the mapped contents of the file
+     * @return Pointer to the first byte or nullptr if no file is open
+     */
+    const char* GetData() const { return mData; }
+
+    /**
+     * Get the size of the mapped file
+     * @return Size in bytes
+     */
+    size_t GetSize() const { return mSize; }
+};
+
+#endif //CANADIANEXPERIENCE_MAPPEDFILE_H
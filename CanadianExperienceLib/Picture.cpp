@@ -4,11 +4,16 @@
  */
 #include "pch.h"
 #include <wx/stdpaths.h>
+#include <frame-profiler.h>
+#include <tracer.h>
 
 #include "Picture.h"
 #include "PictureObserver.h"
 #include "Actor.h"
 #include "MachineAdapter.h"
+#include "AnimBinary.h"
+#include "AnimBinaryWriter.h"
+#include "XmlStreamReader.h"
 
 using namespace std;
 
@@ -48,6 +53,9 @@ Picture::Picture()
  */
 void Picture::SetAnimationTime(double time)
 {
+    FrameProfiler::Scope profile(FrameProfiler::Phase::AnimationTime);
+    Tracer::Scope trace("Picture::SetAnimationTime");
+
     mTimeline.SetCurrentTime(time);
     
     for (auto actor : mActors)
@@ -119,6 +127,8 @@ void Picture::UpdateObservers()
  */
 void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    Tracer::Scope trace("Picture::Draw");
+
     for (auto actor : mActors)
     {
         actor->Draw(graphics);
@@ -146,6 +156,24 @@ void Picture::AddActor(std::shared_ptr<Actor> actor)
     actor->SetPicture(this);
 }
 
+/**
+ * Get a machine by the name it is saved under
+ * @param name Machine name
+ * @return The machine or nullptr if there is no machine with that name
+ */
+std::shared_ptr<MachineAdapter> Picture::GetMachine(const std::wstring& name)
+{
+    for (auto machine : {mMachine1, mMachine2})
+    {
+        if (machine != nullptr && machine->GetName() == name)
+        {
+            return machine;
+        }
+    }
+
+    return nullptr;
+}
+
 /**
  * Save the picture animation to a file
  * @param filename File to save to.
@@ -189,49 +217,124 @@ void Picture::Save(const wxString &filename)
 }
 
 /**
- * Load a picture animation from a file
- * @param filename file to load from
+ * Save the picture animation to a binary animation file
+ * @param filename File to save to.
  */
-void Picture::Load(const wxString &filename)
+void Picture::SaveBinary(const wxString &filename)
 {
-    wxXmlDocument document;
-    document.Load(filename);
+    AnimBinaryWriter writer;
 
-    auto root = document.GetRoot();
-    
-    // Load the timeline animation from the XML
-    mTimeline.Load(root);
-    
-    // Load the machines if present
-    auto machinesNode = root->GetChildren();
-    while (machinesNode != nullptr)
+    // Save the timeline animation
+    mTimeline.Save(writer);
+
+    // Save the machines
+    for (auto machine : {mMachine1, mMachine2})
+    {
+        if (machine != nullptr)
+        {
+            writer.AddMachine(machine->GetName(), machine->GetPosition(), machine->GetMachineNumber(),
+                    machine->GetStartFrame(), machine->GetScale());
+        }
+    }
+
+    writer.Write(filename.ToStdWstring());
+}
+
+/**
+ * Load a picture animation from a file, either
+ * XML or the binary animation format
+ * @param filename file to load from
+ * @return true if successful. If false, the file could not be
+ * read or was malformed and the animation may be only partly loaded.
+ */
+bool Picture::Load(const wxString &filename)
+{
+    if (AnimBinary::IsBinary(filename.ToStdWstring()))
     {
-        if (machinesNode->GetName() == L"machines")
+        return LoadBinary(filename);
+    }
+
+    // The XML is read as a stream rather than into a document,
+    // so the keyframes go straight into the channels
+    XmlStreamReader reader;
+
+    // The machines element we are in, and the machine
+    // within it we are loading, if any
+    bool inMachines = false;
+    std::shared_ptr<MachineAdapter> machine;
+
+    reader.SetStartHandler([this, &inMachines, &machine](const XmlStreamElement& element) {
+        auto name = element.GetName();
+        if (name == "machines")
+        {
+            inMachines = true;
+        }
+        else if (name == "machine" && inMachines)
         {
-            auto machineNode = machinesNode->GetChildren();
-            while (machineNode != nullptr)
+            machine = GetMachine(element.GetAttributeString("name").ToStdWstring());
+            if (machine != nullptr)
             {
-                if (machineNode->GetName() == L"machine")
-                {
-                    wxString name = machineNode->GetAttribute(L"name", L"");
-                    if (name == L"Machine 1" && mMachine1 != nullptr)
-                    {
-                        mMachine1->XmlLoad(machineNode);
-                    }
-                    else if (name == L"Machine 2" && mMachine2 != nullptr)
-                    {
-                        mMachine2->XmlLoad(machineNode);
-                    }
-                }
-                
-                machineNode = machineNode->GetNext();
+                machine->XmlStreamStart(element);
             }
-            
-            break;
         }
-        
-        machinesNode = machinesNode->GetNext();
-    }
+        else if (machine != nullptr)
+        {
+            machine->XmlStreamStart(element);
+        }
+        else if (!inMachines)
+        {
+            // Load the timeline animation
+            mTimeline.XmlStreamStart(element);
+        }
+    });
+
+    reader.SetEndHandler([this, &inMachines, &machine](std::string_view name) {
+        if (name == "machines")
+        {
+            inMachines = false;
+        }
+        else if (name == "machine")
+        {
+            machine = nullptr;
+        }
+        else if (!inMachines)
+        {
+            mTimeline.XmlStreamEnd(name);
+        }
+    });
+
+    return reader.ParseFile(filename.ToStdWstring());
 }
 
+/**
+ * Load a picture animation from a binary animation file
+ * @param filename file to load from
+ * @return true if successful
+ */
+bool Picture::LoadBinary(const wxString &filename)
+{
+    AnimBinary file;
+    if (!file.Open(filename.ToStdWstring()))
+    {
+        return false;
+    }
+
+    // Load the timeline animation
+    mTimeline.Load(file);
+
+    // Load the machines if present
+    for (int i = 0; i < file.GetNumMachines(); i++)
+    {
+        auto machine = GetMachine(file.GetMachineName(i));
+        if (machine != nullptr)
+        {
+            auto& record = file.GetMachine(i);
+            machine->SetPosition(wxPoint(record.mX, record.mY));
+            machine->SetMachineNumber(record.mMachineNumber);
+            machine->SetStartFrame(record.mStartFrame);
+            machine->SetScale(record.mScale);
+        }
+    }
 
+    return true;
+}
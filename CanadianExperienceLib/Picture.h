@@ -38,6 +38,8 @@ private:
     /// Second machine in the picture
     std::shared_ptr<MachineAdapter> mMachine2;
 
+    bool LoadBinary(const wxString& filename);
+
 public:
     /**
      * Constructor
@@ -142,9 +144,11 @@ public:
 
     double GetAnimationTime();
 
-    void Load(const wxString& filename);
+    bool Load(const wxString& filename);
 
     void Save(const wxString& filename);
+
+    void SaveBinary(const wxString& filename);
     
     /**
      * Get the first machine
@@ -157,5 +161,7 @@ public:
      * @return Pointer to second machine
      */
     std::shared_ptr<MachineAdapter> GetMachine2() { return mMachine2; }
+
+    std::shared_ptr<MachineAdapter> GetMachine(const std::wstring& name);
 };
 
@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "PolyDrawable.h"
+#include <graphics-resource-cache.h>
 
 /**
  * Constructor
@@ -30,8 +31,7 @@ void PolyDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
         }
         mPath.CloseSubpath();
 
-        wxBrush brush(mColor);
-        graphics->SetBrush(brush);
+        graphics->SetBrush(GraphicsResourceCache::Get().GetBrush(graphics, mColor));
         graphics->FillPath(mPath);
     }
 
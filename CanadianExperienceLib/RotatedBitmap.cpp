@@ -5,6 +5,8 @@
 
 #include "pch.h"
 #include "RotatedBitmap.h"
+#include <image-cache.h>
+#include <graphics-resource-cache.h>
 
 
 
@@ -14,8 +16,8 @@
  */
 void RotatedBitmap::LoadImage(const std::wstring &filename)
 {
-    mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
-    mLoaded = true;
+    mImage = ImageCache::Get().GetImage(filename);
+    mLoaded = mImage != nullptr;
 }
 
 
@@ -27,15 +29,15 @@ void RotatedBitmap::LoadImage(const std::wstring &filename)
  */
 void RotatedBitmap::DrawImage(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position, double angle)
 {
-    if(!mBitmapCreated)
+    if(!mLoaded)
     {
-        mBitmap = graphics->CreateBitmapFromImage(*mImage);
+        return;
     }
 
     graphics->PushState();
     graphics->Translate(position.x, position.y);
     graphics->Rotate(-angle);
-    graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
+    graphics->DrawBitmap(GraphicsResourceCache::Get().GetBitmap(graphics, mImage), -mCenter.x, -mCenter.y,
             mImage->GetWidth(), mImage->GetHeight());
 
     graphics->PopState();
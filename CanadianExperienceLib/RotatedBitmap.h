@@ -13,14 +13,8 @@
  */
 class RotatedBitmap {
 private:
-    /// The image for this drawable
-    std::unique_ptr<wxImage> mImage;
-
-    /// The graphics bitmap we will use
-    wxGraphicsBitmap mBitmap;
-
-    /// Has mBitmap been created?
-    bool mBitmapCreated = false;
+    /// The image for this drawable, shared through the image cache
+    std::shared_ptr<const wxImage> mImage;
 
     /// The center of the image
     wxPoint mCenter = wxPoint(0, 0);
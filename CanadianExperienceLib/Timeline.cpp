@@ -4,25 +4,94 @@
  */
 
 #include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
 #include "Timeline.h"
 #include "AnimChannel.h"
+#include "AnimChannelAngle.h"
+#include "AnimChannelPoint.h"
+#include "WorkerPool.h"
+#include "AnimBinary.h"
+#include "AnimBinaryWriter.h"
+#include "XmlStreamReader.h"
 
 /**
  * Constructor
  */
 Timeline::Timeline()
 {
+    mThreads = std::max(1, (int)std::thread::hardware_concurrency());
+}
 
+/**
+ * Destructor
+ */
+Timeline::~Timeline()
+{
 }
 
 /**
- * Add an animation channel to the timeline
- * @param channel Channel to add
+ * Register a channel being added to the timeline, giving it an ID.
+ *
+ * A channel must be named before it is added. If channels share a
+ * name, the one added first is the one found by that name.
+ * @param channel Channel to register
  */
-void Timeline::AddChannel(AnimChannel *channel)
+void Timeline::RegisterChannel(AnimChannel* channel)
 {
-    mChannels.push_back(channel);
     channel->SetTimeline(this);
+    channel->SetId((int)mChannels.size());
+    mChannelIds.emplace(channel->GetName(), channel->GetId());
+    mChannels.push_back(channel);
+}
+
+/**
+ * Find a channel by name
+ * @param name Channel name
+ * @return The channel ID or NoChannel if there is no channel with that name
+ */
+int Timeline::FindChannel(const std::wstring& name) const
+{
+    auto found = mChannelIds.find(name);
+    return found != mChannelIds.end() ? found->second : NoChannel;
+}
+
+/**
+ * Add an angle animation channel to the timeline
+ * @param channel Channel to add
+ */
+void Timeline::AddChannel(AnimChannelAngle *channel)
+{
+    RegisterChannel(channel);
+
+    channel->SetSlot((int)mAngleChannels.size());
+    mAngleChannels.push_back(channel);
+    mAngles.push_back(0);
+}
+
+/**
+ * Add a point animation channel to the timeline
+ * @param channel Channel to add
+ */
+void Timeline::AddChannel(AnimChannelPoint *channel)
+{
+    RegisterChannel(channel);
+
+    channel->SetSlot((int)mPointChannels.size());
+    mPointChannels.push_back(channel);
+    mPoints.push_back(wxPoint(0, 0));
+}
+
+/**
+ * Set the number of threads to evaluate channels with once
+ * there are at least ParallelChannels of them
+ * @param threads Number of threads
+ */
+void Timeline::SetThreads(int threads)
+{
+    mThreads = std::max(threads, 1);
+    mPool.reset();
 }
 
 
@@ -37,9 +106,226 @@ void Timeline::SetCurrentTime(double t)
     // Set the time
     mCurrentTime = t;
 
+    int count = (int)(mAngleChannels.size() + mPointChannels.size());
+    RunChannels(count, [this](int first, int last) {
+        EvaluateChannels(first, last);
+    });
+}
+
+/**
+ * Run a task over a range of channels, split between
+ * threads once there are ParallelChannels or more.
+ * @param count Number of channels
+ * @param task Task to run on each block of channels
+ */
+void Timeline::RunChannels(int count, const std::function<void(int first, int last)>& task)
+{
+    if (count < ParallelChannels || mThreads < 2)
+    {
+        task(0, count);
+        return;
+    }
+
+    if (mPool == nullptr)
+    {
+        mPool = std::make_unique<WorkerPool>(mThreads);
+    }
+
+    mPool->Run(count, task);
+}
+
+/**
+ * Evaluate a range of channels for the current time. The angle
+ * channels are numbered first, followed by the point channels.
+ *
+ * Each channel only changes itself and its own slot in the
+ * output buffers, so ranges can be evaluated on different threads.
+ * @param first First channel to evaluate
+ * @param last One past the last channel to evaluate
+ */
+void Timeline::EvaluateChannels(int first, int last)
+{
+    int frame = GetCurrentFrame();
+    int baked = GetBakedFrame();
+    int numAngles = (int)mAngleChannels.size();
+
+    for (int i = first; i < std::min(last, numAngles); i++)
+    {
+        auto channel = mAngleChannels[i];
+        if (baked >= 0 && channel->IsBaked())
+        {
+            mAngles[i] = mBakedAngles[i * mBakedFrames + baked];
+        }
+        else
+        {
+            channel->Evaluate(frame, mAngles[i]);
+        }
+    }
+
+    for (int i = std::max(first, numAngles); i < last; i++)
+    {
+        int slot = i - numAngles;
+        auto channel = mPointChannels[slot];
+        if (baked >= 0 && channel->IsBaked())
+        {
+            mPoints[slot] = mBakedPoints[slot * mBakedFrames + baked];
+        }
+        else
+        {
+            channel->Evaluate(frame, mPoints[slot]);
+        }
+    }
+}
+
+/**
+ * Get the baked frame for the current time
+ * @return Index of the frame's samples, or -1 if the
+ * current time is not on a baked frame
+ */
+int Timeline::GetBakedFrame() const
+{
+    if (mBakedFrames == 0 || mBakedFrameRate != mFrameRate)
+    {
+        return -1;
+    }
+
+    // Bake samples at exactly frame / frame rate, so only
+    // a time that is on a frame can use the samples
+    const double Tolerance = 1e-6;
+    double position = mCurrentTime * mFrameRate;
+    int frame = (int)std::lround(position);
+    int index = frame - mBakedFirst;
+    if (index < 0 || index >= mBakedFrames || std::abs(position - frame) > Tolerance)
+    {
+        return -1;
+    }
+
+    return index;
+}
+
+/**
+ * Sample every channel at every frame from 0 to the number of
+ * frames, so playback and export read values rather than tween.
+ */
+void Timeline::Bake()
+{
+    Bake(0, mNumFrames);
+}
+
+/**
+ * Sample every channel at a range of frames, so playback and
+ * export of those frames read values rather than tween. Other
+ * frames are tweened as usual.
+ *
+ * Only channels whose keyframes changed since the last bake are
+ * sampled, unless the range of frames or the frame rate changed.
+ * The current time is kept.
+ *
+ * @param first First frame to sample
+ * @param last Last frame to sample
+ */
+void Timeline::Bake(int first, int last)
+{
+    first = std::max(first, 0);
+    last = std::min(last, mNumFrames);
+    if (last < first)
+    {
+        return;
+    }
+
+    int frames = last - first + 1;
+    if (first != mBakedFirst || frames != mBakedFrames || mFrameRate != mBakedFrameRate)
+    {
+        // The samples no longer line up, so every channel is resampled
+        for (auto channel : mChannels)
+        {
+            channel->SetBaked(false);
+        }
+
+        mBakedFirst = first;
+        mBakedFrames = frames;
+        mBakedFrameRate = mFrameRate;
+    }
+
+    mBakedAngles.resize(mAngleChannels.size() * frames);
+    mBakedPoints.resize(mPointChannels.size() * frames);
+
+    std::vector<int> angles;
+    for (int i = 0; i < (int)mAngleChannels.size(); i++)
+    {
+        if (!mAngleChannels[i]->IsBaked())
+        {
+            angles.push_back(i);
+        }
+    }
+
+    std::vector<int> points;
+    for (int i = 0; i < (int)mPointChannels.size(); i++)
+    {
+        if (!mPointChannels[i]->IsBaked())
+        {
+            points.push_back(i);
+        }
+    }
+
+    if (angles.empty() && points.empty())
+    {
+        return;
+    }
+
+    double time = mCurrentTime;
+    int numAngles = (int)angles.size();
+    for (int index = 0; index < frames; index++)
+    {
+        // The same time SetCurrentTime is given for this frame
+        // during export, so the samples match tweening exactly
+        mCurrentTime = double(first + index) / mFrameRate;
+        int currFrame = GetCurrentFrame();
+
+        RunChannels(numAngles + (int)points.size(), [&](int begin, int end) {
+            for (int i = begin; i < std::min(end, numAngles); i++)
+            {
+                int slot = angles[i];
+                mAngleChannels[slot]->Evaluate(currFrame, mBakedAngles[slot * frames + index]);
+            }
+
+            for (int i = std::max(begin, numAngles); i < end; i++)
+            {
+                int slot = points[i - numAngles];
+                mPointChannels[slot]->Evaluate(currFrame, mBakedPoints[slot * frames + index]);
+            }
+        });
+    }
+
+    for (auto slot : angles)
+    {
+        mAngleChannels[slot]->SetBaked(true);
+    }
+
+    for (auto slot : points)
+    {
+        mPointChannels[slot]->SetBaked(true);
+    }
+
+    SetCurrentTime(time);
+}
+
+/**
+ * Discard the baked samples
+ */
+void Timeline::ClearBake()
+{
+    mBakedFirst = 0;
+    mBakedFrames = 0;
+    mBakedFrameRate = 0;
+    mBakedAngles.clear();
+    mBakedAngles.shrink_to_fit();
+    mBakedPoints.clear();
+    mBakedPoints.shrink_to_fit();
+
     for (auto channel : mChannels)
     {
-        channel->SetFrame(GetCurrentFrame());
+        channel->SetBaked(false);
     }
 }
 
@@ -74,57 +360,118 @@ void Timeline::Save(wxXmlNode* root)
 
 
 /**
-* Load a timeline animation from XML
-* @param root XML node to load from
-*/
-void Timeline::Load(wxXmlNode* root)
+ * Save the timeline animation to a binary animation file
+ * @param writer Writer for the file
+ */
+void Timeline::Save(AnimBinaryWriter& writer)
+{
+    writer.SetTimeline(mNumFrames, mFrameRate);
+
+    // Channels are written in ID order, as they are to XML
+    for (auto channel : mChannels)
+    {
+        if (auto angle = dynamic_cast<AnimChannelAngle*>(channel))
+        {
+            writer.AddAngleChannel(angle->GetName(), angle->GetKeyframeFrames(), angle->GetKeyframeAngles());
+        }
+        else if (auto point = dynamic_cast<AnimChannelPoint*>(channel))
+        {
+            writer.AddPointChannel(point->GetName(), point->GetKeyframeFrames(), point->GetKeyframePoints());
+        }
+    }
+}
+
+
+/**
+ * Load a timeline animation from a binary animation file.
+ *
+ * The keyframes are copied straight from the file into each
+ * channel. Channels in the file that this timeline does not
+ * have, or that are a different type, are ignored.
+ * @param file The open binary animation file
+ */
+void Timeline::Load(const AnimBinary& file)
 {
-    // Once we know it is open, clear the existing data
     Clear();
 
-    // Get the attributes
-    mNumFrames = wxAtoi(root->GetAttribute(L"numframes", L"300"));
-    mFrameRate = wxAtoi(root->GetAttribute(L"framerate", L"30"));
+    mNumFrames = file.GetNumFrames();
+    mFrameRate = file.GetFrameRate();
 
-    //
-    // Traverse the children of the root
-    // node of the XML document in memory!!!!
-    //
-    auto child = root->GetChildren();
-    for( ; child; child=child->GetNext())
+    for (int i = 0; i < file.GetNumChannels(); i++)
     {
-        auto name = child->GetName();
-        if(name == L"channel")
+        int id = FindChannel(file.GetChannelName(i));
+        if (id == NoChannel)
+        {
+            continue;
+        }
+
+        auto channel = mChannels[id];
+        if (file.GetChannelType(i) == AnimBinary::ChannelType::Angle)
         {
-            XmlChannel(child);
+            if (auto angle = dynamic_cast<AnimChannelAngle*>(channel))
+            {
+                angle->SetKeyframes(file.GetFrames(i), file.GetAngles(i), file.GetNumKeyframes(i));
+            }
+        }
+        else if (auto point = dynamic_cast<AnimChannelPoint*>(channel))
+        {
+            point->SetKeyframes(file.GetFrames(i), file.GetPoints(i), file.GetNumKeyframes(i));
         }
     }
 
+    SetCurrentTime(0);
 }
 
 
 /**
- * Handle the "channel" XML tag.
- * @param node Node that is the channel tag.
+ * Handle an element start tag read by the streaming loader.
+ *
+ * The anim element starts the load. Each channel element is found
+ * in the channel registry and its keyframe elements are inserted
+ * straight into the channel.
+ * @param element The element
  */
-void Timeline::XmlChannel(wxXmlNode* node)
+void Timeline::XmlStreamStart(const XmlStreamElement& element)
 {
-    // Get the channel name
-    auto name = node->GetAttribute(L"name", L"");
+    auto name = element.GetName();
+    if (name == "anim")
+    {
+        Clear();
 
-    // Find the channel
-    for (auto channel : mChannels)
+        mNumFrames = element.GetAttributeInt("numframes", 300);
+        mFrameRate = element.GetAttributeInt("framerate", 30);
+    }
+    else if (name == "channel")
     {
-        if (channel->GetName() == name)
-        {
-            // We found it, let it handle it
-            channel->XmlLoad(node);
-            break;
-        }
+        int id = FindChannel(element.GetAttributeString("name").ToStdWstring());
+        mLoadChannel = id != NoChannel ? mChannels[id] : nullptr;
+    }
+    else if (name == "keyframe" && mLoadChannel != nullptr)
+    {
+        mLoadChannel->XmlStreamKeyframe(element);
     }
 }
 
 
+/**
+ * Handle an element end tag read by the streaming loader
+ * @param name Name of the element
+ */
+void Timeline::XmlStreamEnd(std::string_view name)
+{
+    if (name == "channel")
+    {
+        mLoadChannel = nullptr;
+    }
+    else if (name == "anim")
+    {
+        mLoadChannel = nullptr;
+
+        // Evaluate the loaded channels once
+        SetCurrentTime(0);
+    }
+}
+
 
 /** 
  * Clear all keyframes 
@@ -140,4 +487,6 @@ void Timeline::Clear()
     {
         channel->Clear();
     }
+
+    ClearBake();
 }
\ No newline at end of file
@@ -8,7 +8,18 @@
 #ifndef CANADIANEXPERIENCE_TIMELINE_H
 #define CANADIANEXPERIENCE_TIMELINE_H
 
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
 class AnimChannel;
+class AnimChannelAngle;
+class AnimChannelPoint;
+class WorkerPool;
+class AnimBinary;
+class AnimBinaryWriter;
+class XmlStreamElement;
 
 /**
  * This class implements a timeline that manages the animation
@@ -16,20 +27,91 @@ class AnimChannel;
  * A timeline consists of animation channels for different parts of our
  * actors, each with keyframes that set the position, orientation, etc
  * at that point in time.
+ *
+ * Channels are evaluated by type. The angle channels and the point
+ * channels are each kept in a flat array, and the value each one
+ * computes is written to a matching contiguous buffer that the
+ * actors and drawables read through their channels. Once there are
+ * ParallelChannels channels or more, the evaluation is split
+ * between a pool of worker threads.
+ *
+ * Every channel is registered by name when it is added and given
+ * an ID, its index in the timeline, that does not change. Loading
+ * finds channels through the registry with one hash lookup, and
+ * code that refers to a channel repeatedly can keep its ID.
+ *
+ * Bake samples every channel at every frame, or at a range of
+ * frames. While the current time is on a baked frame, a baked
+ * channel's value is then read from the samples rather than
+ * tweened. Changing a channel's keyframes invalidates only that
+ * channel's samples until the next Bake.
  */
 class Timeline {
 private:
-    void XmlChannel(wxXmlNode* node);
 
     int mNumFrames = 900;       ///< Number of frames in the animation (30 seconds at 30fps)
     int mFrameRate = 30;        ///< Animation frame rate in frames per second
     double mCurrentTime = 0;    ///< The current animation time
 
-    /// List of all animation channels
+    /// List of all animation channels, indexed by channel ID
     std::vector<AnimChannel *> mChannels;
 
+    /// The ID of each channel by name. Each name is hashed once, when
+    /// its channel is added, and the timeline's copy is the only one
+    /// compared when looking a channel up.
+    std::unordered_map<std::wstring, int> mChannelIds;
+
+    /// The angle channels, in the order of their slots in mAngles
+    std::vector<AnimChannelAngle *> mAngleChannels;
+
+    /// The point channels, in the order of their slots in mPoints
+    std::vector<AnimChannelPoint *> mPointChannels;
+
+    /// The current angle of each angle channel
+    std::vector<double> mAngles;
+
+    /// The current point of each point channel
+    std::vector<wxPoint> mPoints;
+
+    /// Number of threads to evaluate channels with
+    int mThreads;
+
+    /// Threads that evaluate channels, created when first needed
+    std::unique_ptr<WorkerPool> mPool;
+
+    /// First frame Bake sampled
+    int mBakedFirst = 0;
+
+    /// Number of samples Bake took of each channel, one for each
+    /// frame from mBakedFirst, or 0 if the timeline has not been baked
+    int mBakedFrames = 0;
+
+    /// Frame rate the baked samples were taken at
+    int mBakedFrameRate = 0;
+
+    /// Baked angles, mBakedFrames samples for each angle channel in slot order
+    std::vector<double> mBakedAngles;
+
+    /// Baked points, mBakedFrames samples for each point channel in slot order
+    std::vector<wxPoint> mBakedPoints;
+
+    /// The channel the streaming loader is reading keyframes for
+    AnimChannel *mLoadChannel = nullptr;
+
+    void RegisterChannel(AnimChannel* channel);
+    void RunChannels(int count, const std::function<void(int first, int last)>& task);
+    void EvaluateChannels(int first, int last);
+    int GetBakedFrame() const;
+
 public:
+    /// Number of channels at which evaluation is split between threads
+    static const int ParallelChannels = 4096;
+
+    /// Channel ID meaning no channel
+    static const int NoChannel = -1;
+
     Timeline();
+    ~Timeline();
 
     /// Copy constructor (disabled)
     Timeline(const Timeline &) = delete;
@@ -86,12 +168,71 @@ public:
 
     void ClearKeyframe();
 
-    void AddChannel(AnimChannel* channel);
+    void AddChannel(AnimChannelAngle* channel);
+
+    void AddChannel(AnimChannelPoint* channel);
+
+    int FindChannel(const std::wstring& name) const;
+
+    /**
+     * Get a channel by its ID
+     * @param id Channel ID, from 0 to GetNumChannels() - 1
+     * @return The channel
+     */
+    AnimChannel* GetChannel(int id) const { return mChannels[id]; }
+
+    /**
+     * Get the number of channels
+     * @return Number of channels
+     */
+    int GetNumChannels() const { return (int)mChannels.size(); }
+
+    /**
+     * Get the current angle of an angle channel
+     * @param slot The channel's slot in the angle buffer
+     * @return Angle in radians
+     */
+    double GetAngle(int slot) const { return mAngles[slot]; }
+
+    /**
+     * Get the current point of a point channel
+     * @param slot The channel's slot in the point buffer
+     * @return The point
+     */
+    wxPoint GetPoint(int slot) const { return mPoints[slot]; }
+
+    /**
+     * Set the number of threads to evaluate channels with once
+     * there are at least ParallelChannels of them
+     * @param threads Number of threads
+     */
+    void SetThreads(int threads);
+
+    /**
+     * Get the number of threads channels are evaluated with
+     * @return Number of threads
+     */
+    int GetThreads() const { return mThreads; }
+
+    void Bake();
+    void Bake(int first, int last);
+    void ClearBake();
+
+    /**
+     * Determine if the timeline has been baked
+     * @return true if Bake has been called since the last ClearBake
+     */
+    bool IsBaked() const { return mBakedFrames > 0; }
 
     void Save(wxXmlNode* root);
 
-    void Load(wxXmlNode* root);
+    void Save(AnimBinaryWriter& writer);
+
+    void Load(const AnimBinary& file);
+
+    void XmlStreamStart(const XmlStreamElement& element);
 
+    void XmlStreamEnd(std::string_view name);
 
 };
 
@@ -7,6 +7,7 @@
 #include <wx/dcbuffer.h>
 #include <wx/stdpaths.h>
 #include <wx/xrc/xmlres.h>
+#include <frame-profiler.h>
 
 #include "ViewEdit.h"
 #include "Picture.h"
@@ -18,6 +19,12 @@
 /// A scaling factor, converts mouse motion to rotation in radians
 const double RotationScaling = 0.02;
 
+/// Height of the profiler overlay text in pixels
+const int ProfilerFontSize = 12;
+
+/// Margin around the profiler overlay text in pixels
+const int ProfilerMargin = 6;
+
 /**
  * Constructor
  * @param parent Parent window for this window
@@ -45,6 +52,10 @@ ViewEdit::ViewEdit(wxFrame* parent) :
         &ViewEdit::OnUpdateEditMove, this, XRCID("EditMove"));
     parent->Bind(wxEVT_UPDATE_UI, 
         &ViewEdit::OnUpdateEditRotate, this, XRCID("EditRotate"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED,
+        &ViewEdit::OnViewProfiler, this, XRCID("ViewProfiler"));
+    parent->Bind(wxEVT_UPDATE_UI,
+        &ViewEdit::OnUpdateViewProfiler, this, XRCID("ViewProfiler"));
 
     mMode = Mode::Move;
 }
@@ -80,6 +91,65 @@ void ViewEdit::OnPaint(wxPaintEvent& event)
     auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
 
     GetPicture()->Draw(graphics);
+
+    if (mShowProfiler)
+    {
+        // Everything since the last paint is one frame
+        FrameProfiler::Get().EndFrame();
+        DrawProfiler(graphics);
+    }
+}
+
+/**
+ * Draw the frame profiler statistics over the top left
+ * of the visible part of the picture
+ * @param graphics Graphics context to draw on
+ */
+void ViewEdit::DrawProfiler(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    auto& profiler = FrameProfiler::Get();
+
+    std::vector<wxString> lines;
+    lines.push_back(wxString::Format(L"%-18s %6s %8s %8s %8s",
+            L"Phase (ms)", L"calls", L"min", L"median", L"p99"));
+    for (int i = 0; i < FrameProfiler::NumPhases; i++)
+    {
+        auto phase = FrameProfiler::Phase(i);
+        auto stats = profiler.GetStats(phase);
+        lines.push_back(wxString::Format(L"%-18s %6d %8.3f %8.3f %8.3f",
+                FrameProfiler::GetName(phase), stats.mCalls, stats.mMin, stats.mMedian, stats.mP99));
+    }
+    lines.push_back(wxString::Format(L"%d frames", int(profiler.GetFrameCount())));
+
+    wxFont font(wxSize(0, ProfilerFontSize),
+            wxFONTFAMILY_TELETYPE,
+            wxFONTSTYLE_NORMAL,
+            wxFONTWEIGHT_NORMAL);
+    graphics->SetFont(font, *wxWHITE);
+
+    double width = 0;
+    double lineHeight = 0;
+    for (auto& line : lines)
+    {
+        double w, h;
+        graphics->GetTextExtent(line, &w, &h);
+        width = std::max(width, w);
+        lineHeight = std::max(lineHeight, h);
+    }
+
+    auto topLeft = CalcUnscrolledPosition(wxPoint(0, 0));
+
+    graphics->SetPen(*wxTRANSPARENT_PEN);
+    graphics->SetBrush(wxBrush(wxColour(0, 0, 0, 180)));
+    graphics->DrawRectangle(topLeft.x, topLeft.y,
+            width + ProfilerMargin * 2, lineHeight * lines.size() + ProfilerMargin * 2);
+
+    double y = topLeft.y + ProfilerMargin;
+    for (auto& line : lines)
+    {
+        graphics->DrawText(line, topLeft.x + ProfilerMargin, y);
+        y += lineHeight;
+    }
 }
 
 /**
@@ -260,3 +330,29 @@ void ViewEdit::OnUpdateEditRotate(wxUpdateUIEvent& event)
 {
     event.Check(mMode == Mode::Rotate);
 }
+
+/**
+ * Handle a View>Profiler menu option, which shows or hides
+ * the frame profiler overlay
+ * @param event The menu event
+ */
+void ViewEdit::OnViewProfiler(wxCommandEvent& event)
+{
+    mShowProfiler = !mShowProfiler;
+
+    // Start from an empty window so the statistics only
+    // cover frames drawn while the overlay is up
+    auto& profiler = FrameProfiler::Get();
+    profiler.Reset();
+    profiler.SetEnabled(mShowProfiler);
+    Refresh();
+}
+
+/**
+ * Advance the user interface for View>Profiler
+ * @param event The event we update
+ */
+void ViewEdit::OnUpdateViewProfiler(wxUpdateUIEvent& event)
+{
+    event.Check(mShowProfiler);
+}
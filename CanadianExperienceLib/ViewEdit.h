@@ -31,6 +31,10 @@ private:
     void OnEditRotate(wxCommandEvent& event);
     void OnUpdateEditMove(wxUpdateUIEvent& event);
     void OnUpdateEditRotate(wxUpdateUIEvent& event);
+    void OnViewProfiler(wxCommandEvent& event);
+    void OnUpdateViewProfiler(wxUpdateUIEvent& event);
+
+    void DrawProfiler(std::shared_ptr<wxGraphicsContext> graphics);
 
     /// The last mouse position
     wxPoint mLastMouse = wxPoint(0, 0);
@@ -41,6 +45,9 @@ private:
     /// The currently selected drawable
     std::shared_ptr<Drawable> mSelectedDrawable;
 
+    /// True if the frame profiler overlay is shown
+    bool mShowProfiler = false;
+
 public:
     /// The current mouse mode
     enum class Mode {Move, Rotate};
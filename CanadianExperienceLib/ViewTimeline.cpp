@@ -7,7 +7,11 @@
 
 #include <wx/dcbuffer.h>
 #include <wx/xrc/xmlres.h>
+#include <wx/stdpaths.h>
+#include <wx/filename.h>
 #include <sstream>
+#include <tracer.h>
+#include <graphics-resource-cache.h>
 
 #include "ViewTimeline.h"
 #include "TimelineDlg.h"
@@ -54,7 +58,7 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir) :
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT);
 
-    mPointerImage = std::make_unique<wxImage>(imagesDir + PointerImageFile, wxBITMAP_TYPE_ANY);
+    mPointerImage = std::make_shared<const wxImage>(imagesDir + PointerImageFile, wxBITMAP_TYPE_ANY);
 
     Bind(wxEVT_PAINT, &ViewTimeline::OnPaint, this);
     Bind(wxEVT_LEFT_DOWN, &ViewTimeline::OnLeftDown, this);
@@ -70,6 +74,11 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir) :
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnPlayPlay, this, XRCID("PlayPlay"));
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnPlayStop, this, XRCID("PlayStop"));
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnPlayPlayFromBeginning, this, XRCID("PlayPlayFromBeginning"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnViewTrace, this, XRCID("ViewTrace"));
+    parent->Bind(wxEVT_UPDATE_UI, &ViewTimeline::OnUpdateViewTrace, this, XRCID("ViewTrace"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnViewSaveTrace, this, XRCID("ViewSaveTrace"));
+
+    mTraceFile = wxFileName(wxStandardPaths::Get().GetTempDir(), L"CanadianExperience.trace.json").GetFullPath().ToStdWstring();
 
     mTimer.SetOwner(this);
     mStopWatch.Start(0);
@@ -107,11 +116,6 @@ void ViewTimeline::OnPaint(wxPaintEvent& event)
     // Create a graphics context
     auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
 
-    if(mPointerBitmap.IsNull())
-    {
-        mPointerBitmap = graphics->CreateBitmapFromImage(*mPointerImage);
-    }
-
     auto rect = GetClientRect();
     int hit = rect.GetHeight();
     int wid = rect.GetWidth();
@@ -156,7 +160,7 @@ void ViewTimeline::OnPaint(wxPaintEvent& event)
     int pw = mPointerImage->GetWidth();
     int ph = mPointerImage->GetHeight();
     int x = BorderLeft + (int)(timeline->GetCurrentTime() * timeline->GetFrameRate() * TickSpacing);
-    graphics->DrawBitmap(mPointerBitmap,
+    graphics->DrawBitmap(GraphicsResourceCache::Get().GetBitmap(graphics, mPointerImage),
             x - pw / 2, top,
             pw, ph
     );
@@ -272,6 +276,10 @@ void ViewTimeline::OnPlayPlay(wxCommandEvent& event)
 
     auto timeline = GetPicture()->GetTimeline();
 
+    // Playback reads the baked samples. Only channels
+    // edited since the last playback are sampled again.
+    timeline->Bake();
+
     auto frameRate = timeline->GetFrameRate();
     auto time = timeline->GetCurrentTime();
 
@@ -311,6 +319,7 @@ void ViewTimeline::OnPlayPlayFromBeginning(wxCommandEvent& event)
     }
 
     auto timeline = GetPicture()->GetTimeline();
+    timeline->Bake();
     auto frameRate = timeline->GetFrameRate();
 
     mPlaying = true;
@@ -334,6 +343,8 @@ void ViewTimeline::OnPlayStop(wxCommandEvent& event)
  */
 void ViewTimeline::OnTimer(wxTimerEvent& event)
 {
+    Tracer::Scope trace("ViewTimeline::OnTimer");
+
     auto timeline = GetPicture()->GetTimeline();
 
     auto newTime = mStopWatch.Time() / 1000.0;
@@ -346,6 +357,13 @@ void ViewTimeline::OnTimer(wxTimerEvent& event)
         Stop();
     }
 
+    // A baked timeline only reads its samples on a
+    // frame, so play the nearest frame
+    if (timeline->IsBaked())
+    {
+        newTime = double(frame) / frameRate;
+    }
+
     GetPicture()->SetAnimationTime(newTime);
 }
 
@@ -358,6 +376,13 @@ void ViewTimeline::Stop()
     mPlaying = false;
     mTimer.Stop();
     mStopWatch.Pause();
+
+    // Save what was recorded during playback
+    auto& tracer = Tracer::Get();
+    if (tracer.IsEnabled() && tracer.Write(mTraceFile))
+    {
+        wxLogStatus(L"Trace saved to %s", mTraceFile);
+    }
 }
 
 
@@ -368,14 +393,21 @@ void ViewTimeline::Stop()
 void ViewTimeline::OnFileSaveAs(wxCommandEvent& event)
 {
     wxFileDialog saveFileDialog(this, _("Save Animation file"), "", "",
-            "Animation Files (*.anim)|*.anim", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+            "Animation Files (*.anim)|*.anim|Binary Animation Files (*.anim)|*.anim", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
     if (saveFileDialog.ShowModal() == wxID_CANCEL)
     {
         return;
     }
 
     auto filename = saveFileDialog.GetPath();
-    GetPicture()->Save(filename);
+    if (saveFileDialog.GetFilterIndex() == 1)
+    {
+        GetPicture()->SaveBinary(filename);
+    }
+    else
+    {
+        GetPicture()->Save(filename);
+    }
 }
 
 /**
@@ -392,6 +424,55 @@ void ViewTimeline::OnFileOpen(wxCommandEvent& event)
     }
 
     auto filename = loadFileDialog.GetPath();
-    GetPicture()->Load(filename);
+    if (!GetPicture()->Load(filename))
+    {
+        wxMessageBox(L"Unable to read all of " + filename);
+    }
+
     Refresh();
-}
\ No newline at end of file
+}
+
+/**
+ * View>Trace Playback menu handler. Turning tracing on
+ * discards anything recorded before.
+ * @param event Menu event
+ */
+void ViewTimeline::OnViewTrace(wxCommandEvent& event)
+{
+    auto& tracer = Tracer::Get();
+    if (!tracer.IsEnabled())
+    {
+        tracer.Clear();
+    }
+
+    tracer.SetEnabled(!tracer.IsEnabled());
+}
+
+/**
+ * Update handler for View>Trace Playback
+ * @param event Update event
+ */
+void ViewTimeline::OnUpdateViewTrace(wxUpdateUIEvent& event)
+{
+    event.Check(Tracer::Get().IsEnabled());
+}
+
+/**
+ * View>Save Trace menu handler
+ * @param event Menu event
+ */
+void ViewTimeline::OnViewSaveTrace(wxCommandEvent& event)
+{
+    wxFileDialog saveFileDialog(this, _("Save Trace file"), "", "",
+            "Trace Files (*.json)|*.json", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+    if (saveFileDialog.ShowModal() == wxID_CANCEL)
+    {
+        return;
+    }
+
+    auto filename = saveFileDialog.GetPath().ToStdWstring();
+    if (!Tracer::Get().Write(filename))
+    {
+        wxMessageBox(L"Unable to write " + filename);
+    }
+}
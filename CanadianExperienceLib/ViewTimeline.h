@@ -29,12 +29,12 @@ private:
     void OnPlayPlayFromBeginning(wxCommandEvent& event);
     void OnFileSaveAs(wxCommandEvent& event);
     void OnFileOpen(wxCommandEvent& event);
+    void OnViewTrace(wxCommandEvent& event);
+    void OnUpdateViewTrace(wxUpdateUIEvent& event);
+    void OnViewSaveTrace(wxCommandEvent& event);
 
     /// Bitmap image for the pointer
-    std::unique_ptr<wxImage> mPointerImage;
-
-    /// Graphics bitmap to display
-    wxGraphicsBitmap mPointerBitmap;
+    std::shared_ptr<const wxImage> mPointerImage;
 
     /// Flag to indicate we are moving the pointer
     bool mMovingPointer = false;
@@ -48,6 +48,9 @@ private:
     /// Are we playing?
     bool mPlaying = false;
 
+    /// File the trace is saved to when playback stops
+    std::wstring mTraceFile;
+
 public:
     static const int Height = 90;      ///< Height to make this window
 
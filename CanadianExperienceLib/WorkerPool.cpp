@@ -0,0 +1,118 @@
+/**
+ * @file WorkerPool.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "WorkerPool.h"
+
+/**
+ * Constructor
+ * @param threads Number of threads to split work between,
+ * including the thread that calls Run
+ */
+WorkerPool::WorkerPool(int threads)
+{
+    for (int i = 1; i < threads; i++)
+    {
+        mWorkers.emplace_back(&WorkerPool::Work, this, i);
+    }
+}
+
+/**
+ * Destructor, stops the workers
+ */
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mStart.notify_all();
+
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * Do a task on the items 0 to count-1, split between the threads,
+ * and return once it is done
+ * @param count Number of items
+ * @param task Task to do on each block of items
+ */
+void WorkerPool::Run(int count, const Task& task)
+{
+    if (mWorkers.empty())
+    {
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = &task;
+        mCount = count;
+        mRemaining = (int)mWorkers.size();
+        mRun++;
+    }
+    mStart.notify_all();
+
+    RunBlock(task, count, 0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]() { return mRemaining == 0; });
+    mTask = nullptr;
+}
+
+/**
+ * Do one thread's block of a run
+ * @param task Task to do
+ * @param count Number of items in the run
+ * @param index Index of the thread, 0 for the caller of Run
+ */
+void WorkerPool::RunBlock(const Task& task, int count, int index)
+{
+    int threads = GetThreads();
+    int first = int((long long)count * index / threads);
+    int last = int((long long)count * (index + 1) / threads);
+    if (first < last)
+    {
+        task(first, last);
+    }
+}
+
+/**
+ * The loop each worker thread runs until the pool is destroyed
+ * @param index Index of this worker's block in each run
+ */
+void WorkerPool::Work(int index)
+{
+    unsigned long long done = 0;
+    while (true)
+    {
+        const Task* task;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStart.wait(lock, [this, done]() { return mStop || mRun != done; });
+            if (mStop)
+            {
+                return;
+            }
+
+            done = mRun;
+            task = mTask;
+            count = mCount;
+        }
+
+        RunBlock(*task, count, index);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRemaining--;
+        }
+        mDone.notify_one();
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file WorkerPool.h
+ * @author Aditya Menon
+ *
+ * A fixed set of threads that split a range of work between them
+ */
+
+#ifndef CANADIANEXPERIENCE_WORKERPOOL_H
+#define CANADIANEXPERIENCE_WORKERPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of threads that split a range of work between them.
+ *
+ * Run divides the items 0 to count-1 into one contiguous block
+ * per thread and returns once every block is done. The calling
+ * thread does the first block itself, so a pool of n threads
+ * starts n-1 workers. The workers wait between calls, so a pool
+ * can be run every frame without starting threads each time.
+ *
+ * Run must only be called from one thread at a time.
+ */
+class WorkerPool
+{
+public:
+    /// Work on the items first to last-1
+    typedef std::function<void(int first, int last)> Task;
+
+private:
+    /// The worker threads
+    std::vector<std::thread> mWorkers;
+
+    /// The task of the current run
+    const Task* mTask = nullptr;
+
+    /// Number of items in the current run
+    int mCount = 0;
+
+    /// Incremented for each run so the workers know there is work
+    unsigned long long mRun = 0;
+
+    /// Number of workers that have not finished the current run
+    int mRemaining = 0;
+
+    /// True when the workers should exit
+    bool mStop = false;
+
+    /// Protects the members above
+    std::mutex mMutex;
+
+    /// Signalled when a run starts or the pool stops
+    std::condition_variable mStart;
+
+    /// Signalled when a worker finishes its block
+    std::condition_variable mDone;
+
+    void Work(int index);
+    void RunBlock(const Task& task, int count, int index);
+
+public:
+    explicit WorkerPool(int threads);
+    ~WorkerPool();
+
+    /// Copy constructor (disabled)
+    WorkerPool(const WorkerPool &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const WorkerPool &) = delete;
+
+    void Run(int count, const Task& task);
+
+    /**
+     * Get the number of threads work is split between,
+     * including the thread that calls Run
+     * @return Number of threads
+     */
+    int GetThreads() const { return (int)mWorkers.size() + 1; }
+};
+
+#endif //CANADIANEXPERIENCE_WORKERPOOL_H
@@ -0,0 +1,392 @@
+/**
+ * @file XmlStreamReader.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <cstdlib>
+#include <cstring>
+#include "XmlStreamReader.h"
+#include "MappedFile.h"
+
+/**
+ * Determine if a character is XML white space
+ * @param c Character
+ * @return true if white space
+ */
+static bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * Determine if a character ends a name
+ * @param c Character
+ * @return true if the character can not be part of a name
+ */
+static bool IsNameEnd(char c)
+{
+    return IsSpace(c) || c == '/' || c == '>' || c == '=';
+}
+
+/**
+ * Append a character code to a string as UTF-8
+ * @param str String to append to
+ * @param code Unicode code point
+ */
+static void AppendUTF8(std::string& str, unsigned long code)
+{
+    if (code < 0x80)
+    {
+        str += char(code);
+    }
+    else if (code < 0x800)
+    {
+        str += char(0xc0 | (code >> 6));
+        str += char(0x80 | (code & 0x3f));
+    }
+    else if (code < 0x10000)
+    {
+        str += char(0xe0 | (code >> 12));
+        str += char(0x80 | ((code >> 6) & 0x3f));
+        str += char(0x80 | (code & 0x3f));
+    }
+    else
+    {
+        str += char(0xf0 | (code >> 18));
+        str += char(0x80 | ((code >> 12) & 0x3f));
+        str += char(0x80 | ((code >> 6) & 0x3f));
+        str += char(0x80 | (code & 0x3f));
+    }
+}
+
+/**
+ * Find an attribute value
+ * @param name Attribute name
+ * @return Pointer to the raw value or nullptr if there is no such attribute
+ */
+const std::string_view* XmlStreamElement::Find(std::string_view name) const
+{
+    for (auto& attribute : mAttributes)
+    {
+        if (attribute.mName == name)
+        {
+            return &attribute.mValue;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Get an attribute value with its character references replaced
+ * @param name Attribute name
+ * @param def Value to return if there is no such attribute
+ * @return Attribute value in UTF-8
+ */
+std::string XmlStreamElement::GetAttribute(std::string_view name, const std::string& def) const
+{
+    auto value = Find(name);
+    if (value == nullptr)
+    {
+        return def;
+    }
+
+    std::string result;
+    result.reserve(value->size());
+    for (size_t i = 0; i < value->size(); i++)
+    {
+        char c = (*value)[i];
+        auto semicolon = value->find(';', i);
+        if (c != '&' || semicolon == std::string_view::npos)
+        {
+            result += c;
+            continue;
+        }
+
+        auto entity = value->substr(i + 1, semicolon - i - 1);
+        if (entity == "lt") result += '<';
+        else if (entity == "gt") result += '>';
+        else if (entity == "amp") result += '&';
+        else if (entity == "quot") result += '"';
+        else if (entity == "apos") result += '\'';
+        else if (entity.size() > 1 && entity[0] == '#')
+        {
+            bool hex = entity[1] == 'x';
+            std::string digits(entity.substr(hex ? 2 : 1));
+            AppendUTF8(result, strtoul(digits.c_str(), nullptr, hex ? 16 : 10));
+        }
+        else
+        {
+            // Not a reference we know, keep it as it is
+            result += c;
+            continue;
+        }
+
+        i = semicolon;
+    }
+
+    return result;
+}
+
+/**
+ * Get an attribute value as a wxString
+ * @param name Attribute name
+ * @param def Value to return if there is no such attribute
+ * @return Attribute value
+ */
+wxString XmlStreamElement::GetAttributeString(std::string_view name, const wxString& def) const
+{
+    if (Find(name) == nullptr)
+    {
+        return def;
+    }
+
+    auto value = GetAttribute(name);
+    return wxString::FromUTF8(value.data(), value.size());
+}
+
+/**
+ * Get an attribute value as an integer, the way wxAtoi would
+ * @param name Attribute name
+ * @param def Value to return if there is no such attribute
+ * @return Attribute value
+ */
+int XmlStreamElement::GetAttributeInt(std::string_view name, int def) const
+{
+    auto value = Find(name);
+    if (value == nullptr)
+    {
+        return def;
+    }
+
+    // The value is always followed by its closing quote,
+    // so it can be converted where it is
+    return (int)strtol(value->data(), nullptr, 10);
+}
+
+/**
+ * Get an attribute value as a double
+ * @param name Attribute name
+ * @param def Value to return if there is no such attribute
+ * @return Attribute value
+ */
+double XmlStreamElement::GetAttributeDouble(std::string_view name, double def) const
+{
+    auto value = Find(name);
+    if (value == nullptr)
+    {
+        return def;
+    }
+
+    return strtod(value->data(), nullptr);
+}
+
+/**
+ * Map a file into memory and parse it
+ * @param filename File to parse
+ * @return true if the file was read and is well formed
+ */
+bool XmlStreamReader::ParseFile(const std::wstring& filename)
+{
+    MappedFile file;
+    if (!file.Open(filename))
+    {
+        return false;
+    }
+
+    return Parse(file.GetData(), file.GetSize());
+}
+
+/**
+ * Parse XML in memory, calling the handlers as each tag is read
+ * @param data The XML
+ * @param size Size of the XML in bytes
+ * @return true if the XML is well formed. If false, the handlers
+ * have been called for the tags before the error.
+ */
+bool XmlStreamReader::Parse(const char* data, size_t size)
+{
+    const char* p = data;
+    const char* end = data + size;
+
+    // Skip to the first occurrence of a terminator, leaving p after it
+    auto skipPast = [&p, end](const char* terminator) {
+        size_t length = strlen(terminator);
+        for ( ; p + length <= end; p++)
+        {
+            if (memcmp(p, terminator, length) == 0)
+            {
+                p += length;
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    auto skipSpace = [&p, end]() {
+        while (p < end && IsSpace(*p))
+        {
+            p++;
+        }
+    };
+
+    auto readName = [&p, end]() {
+        auto start = p;
+        while (p < end && !IsNameEnd(*p))
+        {
+            p++;
+        }
+
+        return std::string_view(start, p - start);
+    };
+
+    // The open elements, so end tags can be matched
+    std::vector<std::string_view> open;
+
+    // Reused for every element so reading does not allocate
+    XmlStreamElement element;
+
+    // Skip a UTF-8 byte order mark
+    if (size >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0)
+    {
+        p += 3;
+    }
+
+    while (true)
+    {
+        // Text content is skipped
+        p = static_cast<const char*>(memchr(p, '<', end - p));
+        if (p == nullptr)
+        {
+            break;
+        }
+
+        p++;
+        if (p >= end)
+        {
+            return false;
+        }
+
+        if (*p == '?')
+        {
+            if (!skipPast("?>"))
+                return false;
+        }
+        else if (end - p >= 3 && memcmp(p, "!--", 3) == 0)
+        {
+            if (!skipPast("-->"))
+                return false;
+        }
+        else if (end - p >= 8 && memcmp(p, "![CDATA[", 8) == 0)
+        {
+            if (!skipPast("]]>"))
+                return false;
+        }
+        else if (*p == '!')
+        {
+            if (!skipPast(">"))
+                return false;
+        }
+        else if (*p == '/')
+        {
+            p++;
+            auto name = readName();
+            skipSpace();
+            if (p >= end || *p != '>' || open.empty() || open.back() != name)
+            {
+                return false;
+            }
+
+            p++;
+            open.pop_back();
+            if (mEndHandler)
+            {
+                mEndHandler(name);
+            }
+        }
+        else
+        {
+            element.mName = readName();
+            element.mAttributes.clear();
+            if (element.mName.empty())
+            {
+                return false;
+            }
+
+            bool empty = false;
+            while (true)
+            {
+                skipSpace();
+                if (p >= end)
+                {
+                    return false;
+                }
+
+                if (*p == '>')
+                {
+                    p++;
+                    break;
+                }
+
+                if (*p == '/')
+                {
+                    if (end - p < 2 || p[1] != '>')
+                    {
+                        return false;
+                    }
+
+                    p += 2;
+                    empty = true;
+                    break;
+                }
+
+                XmlStreamElement::Attribute attribute;
+                attribute.mName = readName();
+                skipSpace();
+                if (attribute.mName.empty() || p >= end || *p != '=')
+                {
+                    return false;
+                }
+
+                p++;
+                skipSpace();
+                if (p >= end || (*p != '"' && *p != '\''))
+                {
+                    return false;
+                }
+
+                char quote = *p++;
+                auto close = static_cast<const char*>(memchr(p, quote, end - p));
+                if (close == nullptr)
+                {
+                    return false;
+                }
+
+                attribute.mValue = std::string_view(p, close - p);
+                element.mAttributes.push_back(attribute);
+                p = close + 1;
+            }
+
+            if (mStartHandler)
+            {
+                mStartHandler(element);
+            }
+
+            if (empty)
+            {
+                if (mEndHandler)
+                {
+                    mEndHandler(element.mName);
+                }
+            }
+            else
+            {
+                open.push_back(element.mName);
+            }
+        }
+    }
+
+    return open.empty();
+}
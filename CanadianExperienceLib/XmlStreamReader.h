@@ -0,0 +1,118 @@
+/**
+ * @file XmlStreamReader.h
+ * @author Aditya Menon
+ *
+ * Streaming reader for XML animation files
+ */
+
+#ifndef CANADIANEXPERIENCE_XMLSTREAMREADER_H
+#define CANADIANEXPERIENCE_XMLSTREAMREADER_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * An element start tag reported by XmlStreamReader.
+ *
+ * The name and attribute values point into the file being
+ * read and are only valid during the start handler.
+ */
+class XmlStreamElement
+{
+public:
+    /// One attribute of the element, as it appears in the file
+    struct Attribute
+    {
+        std::string_view mName;     ///< Attribute name
+        std::string_view mValue;    ///< Value, with any entity references still in it
+    };
+
+private:
+    /// The element name
+    std::string_view mName;
+
+    /// The attributes in the order they appear
+    std::vector<Attribute> mAttributes;
+
+    friend class XmlStreamReader;
+
+    const std::string_view* Find(std::string_view name) const;
+
+public:
+    /**
+     * Get the element name
+     * @return Name of the element
+     */
+    std::string_view GetName() const { return mName; }
+
+    std::string GetAttribute(std::string_view name, const std::string& def = "") const;
+    wxString GetAttributeString(std::string_view name, const wxString& def = L"") const;
+    int GetAttributeInt(std::string_view name, int def = 0) const;
+    double GetAttributeDouble(std::string_view name, double def = 0) const;
+
+    /**
+     * Determine if the element has an attribute
+     * @param name Attribute name
+     * @return true if the attribute is present
+     */
+    bool HasAttribute(std::string_view name) const { return Find(name) != nullptr; }
+};
+
+/**
+ * Streaming reader for XML animation files.
+ *
+ * The file is mapped into memory and scanned once from start to
+ * end, calling the start handler for each element start tag and
+ * the end handler for each end tag. No document is built, so
+ * loading uses no memory beyond the mapping no matter how large
+ * the file is.
+ *
+ * This reads the XML the program writes: elements, attributes,
+ * the standard and numeric character references, comments,
+ * processing instructions and a DOCTYPE without an internal subset.
+ * Text content is skipped.
+ */
+class XmlStreamReader
+{
+public:
+    /// Handler called for each element start tag
+    typedef std::function<void(const XmlStreamElement& element)> StartHandler;
+
+    /// Handler called for each element end tag, including empty elements
+    typedef std::function<void(std::string_view name)> EndHandler;
+
+private:
+    /// Handler for start tags
+    StartHandler mStartHandler;
+
+    /// Handler for end tags
+    EndHandler mEndHandler;
+
+public:
+    XmlStreamReader() {}
+
+    /// Copy constructor (disabled)
+    XmlStreamReader(const XmlStreamReader &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const XmlStreamReader &) = delete;
+
+    /**
+     * Set the handler called for each element start tag
+     * @param handler Handler to call
+     */
+    void SetStartHandler(StartHandler handler) { mStartHandler = handler; }
+
+    /**
+     * Set the handler called for each element end tag
+     * @param handler Handler to call
+     */
+    void SetEndHandler(EndHandler handler) { mEndHandler = handler; }
+
+    bool ParseFile(const std::wstring& filename);
+    bool Parse(const char* data, size_t size);
+};
+
+#endif //CANADIANEXPERIENCE_XMLSTREAMREADER_H
@@ -0,0 +1,78 @@
+/**
+ * @file ConvertApp.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+
+#include "ConvertApp.h"
+#include <AnimBinary.h>
+#include <AnimConverter.h>
+
+/// Command line options
+static const wxCmdLineEntryDesc CommandLineOptions[] =
+{
+    { wxCMD_LINE_SWITCH, "h", "help", "show this help", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, "input animation file", wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, "output animation file", wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_NONE }
+};
+
+/**
+ * Describe the command line options
+ * @param parser Command line parser
+ */
+void ConvertApp::OnInitCmdLine(wxCmdLineParser& parser)
+{
+    parser.SetDesc(CommandLineOptions);
+    parser.SetSwitchChars("-");
+}
+
+/**
+ * Handle the parsed command line
+ * @param parser Command line parser
+ * @return True if the command line is usable
+ */
+bool ConvertApp::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+    mInputFile = parser.GetParam(0);
+    mOutputFile = parser.GetParam(1);
+    return true;
+}
+
+/**
+ * Convert the animation
+ * @return Exit code, 0 if successful
+ */
+int ConvertApp::OnRun()
+{
+    if (!wxFileName::FileExists(mInputFile))
+    {
+        wxPrintf("Unable to open animation file %s\n", mInputFile);
+        return 1;
+    }
+
+    auto input = mInputFile.ToStdWstring();
+    auto output = mOutputFile.ToStdWstring();
+    if (AnimBinary::IsBinary(input))
+    {
+        if (!AnimConverter::BinaryToXml(input, output))
+        {
+            wxPrintf("Unable to convert %s to XML\n", mInputFile);
+            return 1;
+        }
+    }
+    else
+    {
+        if (!AnimConverter::XmlToBinary(input, output))
+        {
+            wxPrintf("Unable to convert %s to binary\n", mInputFile);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file ConvertApp.h
+ * @author Aditya Menon
+ *
+ * Command-line application that converts animation files
+ * between the XML and binary formats
+ */
+
+#ifndef CANADIANEXPERIENCE_CONVERTAPP_H
+#define CANADIANEXPERIENCE_CONVERTAPP_H
+
+/**
+ * Command-line application that converts animation files
+ * between the XML and binary formats.
+ *
+ * Usage: CanadianExperienceConvert input.anim output.anim
+ *
+ * A binary input file is converted to XML and an
+ * XML input file is converted to binary.
+ */
+class ConvertApp : public wxAppConsole {
+private:
+    /// Animation file to convert
+    wxString mInputFile;
+
+    /// File to write the converted animation to
+    wxString mOutputFile;
+
+public:
+    void OnInitCmdLine(wxCmdLineParser& parser) override;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) override;
+    int OnRun() override;
+};
+
+#endif //CANADIANEXPERIENCE_CONVERTAPP_H
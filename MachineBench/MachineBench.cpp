@@ -0,0 +1,226 @@
+/**
+ * @file MachineBench.cpp
+ *
+ * @author Aditya Menon
+ *
+ * Benchmarks for the MachineLib hot paths
+ */
+
+#include "pch.h"
+#include <benchmark/benchmark.h>
+#include <wx/graphics.h>
+#include <random>
+
+#include <MachineSystem.h>
+#include <MachineFactory1.h>
+#include <MachineFactory2.h>
+#include <Machine.h>
+#include <BubbleBlower.h>
+#include <FlappingBelt.h>
+#include <Polygon.h>
+
+/// Directory containing the machine resources
+const std::wstring ResourcesDir = L"" MACHINE_RESOURCES_DIR;
+
+/// Width of the offscreen drawing surface in pixels
+const int SurfaceWidth = 800;
+
+/// Height of the offscreen drawing surface in pixels
+const int SurfaceHeight = 600;
+
+/// Number of frames the seek benchmarks choose from, one minute at 30fps
+const int SeekFrames = 30 * 60;
+
+/**
+ * An offscreen image and a graphics context that draws into it
+ */
+struct Surface
+{
+    /// Image drawn into
+    wxImage mImage{SurfaceWidth, SurfaceHeight};
+
+    /// Graphics context for the image
+    std::shared_ptr<wxGraphicsContext> mGraphics{wxGraphicsContext::Create(mImage)};
+};
+
+/**
+ * A fixed sequence of random frames, the same for every run
+ * @return Frame numbers
+ */
+static std::vector<int> RandomFrames()
+{
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> distribution(0, SeekFrames - 1);
+
+    std::vector<int> frames(1024);
+    for (auto& frame : frames)
+    {
+        frame = distribution(random);
+    }
+
+    return frames;
+}
+
+/**
+ * Play a machine forward one frame at a time
+ * @param state Benchmark state, range(0) is the machine number
+ */
+static void SetMachineFrameSequential(benchmark::State& state)
+{
+    MachineSystem machine(ResourcesDir);
+    machine.ChooseMachine(int(state.range(0)));
+
+    int frame = 0;
+    for (auto _ : state)
+    {
+        machine.SetMachineFrame(frame);
+        frame = (frame + 1) % SeekFrames;
+    }
+}
+BENCHMARK(SetMachineFrameSequential)->Arg(1)->Arg(2);
+
+/**
+ * Seek a machine to random frames
+ * @param state Benchmark state, range(0) is the machine number
+ */
+static void SetMachineFrameRandom(benchmark::State& state)
+{
+    MachineSystem machine(ResourcesDir);
+    machine.ChooseMachine(int(state.range(0)));
+
+    auto frames = RandomFrames();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        machine.SetMachineFrame(frames[i]);
+        i = (i + 1) % frames.size();
+    }
+}
+BENCHMARK(SetMachineFrameRandom)->Arg(1)->Arg(2);
+
+/**
+ * Build machine 1
+ * @param state Benchmark state
+ */
+static void MachineFactory1Create(benchmark::State& state)
+{
+    auto factory = MachineFactory1::Create(ResourcesDir);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(factory->Create());
+    }
+}
+BENCHMARK(MachineFactory1Create)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Build machine 2
+ * @param state Benchmark state
+ */
+static void MachineFactory2Create(benchmark::State& state)
+{
+    auto factory = MachineFactory2::Create(ResourcesDir);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(factory->Create());
+    }
+}
+BENCHMARK(MachineFactory2Create)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Advance a bubble blower holding about range(0) live bubbles
+ *
+ * The blower is not turning, so Update only moves the bubbles it
+ * has. Bubbles that pop or leave are replaced outside the timed
+ * region whenever the count falls below three quarters of the target.
+ * @param state Benchmark state, range(0) is the number of bubbles
+ */
+static void BubbleBlowerUpdate(benchmark::State& state)
+{
+    auto target = size_t(state.range(0));
+
+    BubbleBlower blower;
+    blower.SetPosition(SurfaceWidth / 2, SurfaceHeight - 100);
+    blower.SetSeed(1);
+
+    size_t processed = 0;
+    for (auto _ : state)
+    {
+        if (blower.GetBubbleCount() < target * 3 / 4)
+        {
+            state.PauseTiming();
+            while (blower.GetBubbleCount() < target)
+            {
+                blower.CreateBubble();
+            }
+            state.ResumeTiming();
+        }
+
+        processed += blower.GetBubbleCount();
+        blower.Update();
+    }
+
+    state.SetItemsProcessed(int64_t(processed));
+}
+BENCHMARK(BubbleBlowerUpdate)->RangeMultiplier(4)->Range(64, 16384);
+
+/**
+ * Draw a color polygon into an offscreen image
+ * @param state Benchmark state
+ */
+static void DrawPolygonColor(benchmark::State& state)
+{
+    Surface surface;
+
+    cse335::Polygon polygon;
+    polygon.Circle(50);
+    polygon.SetColor(wxColour(200, 40, 40));
+
+    for (auto _ : state)
+    {
+        polygon.DrawPolygon(surface.mGraphics, SurfaceWidth / 2, SurfaceHeight / 2);
+    }
+}
+BENCHMARK(DrawPolygonColor);
+
+/**
+ * Draw an image polygon into an offscreen image
+ * @param state Benchmark state
+ */
+static void DrawPolygonImage(benchmark::State& state)
+{
+    Surface surface;
+
+    cse335::Polygon polygon;
+    polygon.CenteredSquare(100);
+    polygon.SetImage(ResourcesDir + L"/images/pulley.png");
+
+    for (auto _ : state)
+    {
+        polygon.DrawPolygon(surface.mGraphics, SurfaceWidth / 2, SurfaceHeight / 2);
+    }
+}
+BENCHMARK(DrawPolygonImage);
+
+/**
+ * Draw a flapping belt into an offscreen image
+ * @param state Benchmark state
+ */
+static void FlappingBeltDraw(benchmark::State& state)
+{
+    Surface surface;
+
+    FlappingBelt belt;
+    belt.AddPoint(wxPoint(0, -5));
+    belt.AddPoint(wxPoint(300, -5));
+    belt.AddPoint(wxPoint(300, 5));
+    belt.AddPoint(wxPoint(0, 5));
+
+    double time = 0;
+    for (auto _ : state)
+    {
+        belt.SetTime(time);
+        belt.Draw(surface.mGraphics, wxPoint(100, SurfaceHeight / 2));
+        time += 1.0 / 30;
+    }
+}
+BENCHMARK(FlappingBeltDraw);
@@ -5,8 +5,9 @@
 
 #include "pch.h"
 #include "BubbleBlower.h"
-#include "Bubble.h"
 #include "Polygon.h"
+#include "Tracer.h"
+#include <algorithm>
 
 // Initialize static constants
 const double BubbleBlower::BubblePerRotation = 5.0;
@@ -18,6 +19,17 @@ const double BubbleBlower::BubbleBlowerOffsetVariance = 5.0;
 const double BubbleBlower::BubbleMinimumVelocity = 20.0;
 const double BubbleBlower::BubbleMaximumVelocity = 40.0;
 
+/// Number of bubble integration steps per machine update. The machine
+/// used to update every component three times per frame, and the bubble
+/// motion was tuned to that pace.
+const int BubbleStepsPerUpdate = 3;
+
+/// Bubbles are removed once they are this far from the blower in X
+const double BubbleCullX = 800;
+
+/// Bubbles are removed once they are this far from the blower in Y
+const double BubbleCullY = 600;
+
 /**
  * Constructor
  */
@@ -32,9 +44,15 @@ BubbleBlower::BubbleBlower()
     mSink = std::make_shared<Sink>();
     mSink->SetComponent(this);
     
-    // Initialize the random number generator
-    std::random_device rd;  // Generates a random seed
-    mRandom.seed(rd());     // Seed the random number generator
+    // One polygon is shared by every bubble. Without an image
+    // directory the bubbles are drawn red so they are visible.
+    mBubbleSprite = std::make_shared<cse335::Polygon>();
+    mBubbleSprite->Circle(BubbleParticles::BubbleInitialRadius);
+    mBubbleSprite->SetColor(wxColor(255, 0, 0, 255));
+    mBubbles.SetBounds(BubbleCullX, BubbleCullY);
+    
+    // Start the simulation from the default seed
+    Reset();
     
     // Tilt the bubble blower slightly to the left (negative rotation)
     SetCurrentRotation(-0.3);  // About -17 degrees - more tilt to the left
@@ -50,71 +68,27 @@ void BubbleBlower::Draw(std::shared_ptr<wxGraphicsContext> graphics, wxPoint pos
     // Draw the bubble blower itself 
     Component::Draw(graphics, position);
     
-    // Draw all the bubbles with correct positioning
-    // We need to apply the position offset to the bubbles since they're in component coordinates
-    for (auto bubble : mBubbles)
-    {
-        // Get the bubble's current position
-        wxPoint2DDouble bubblePos = bubble->GetPosition();
-        
-        // Save original position
-        wxPoint2DDouble originalPos = bubblePos;
-        
-        // Apply machine position offset to convert from component to screen coordinates
-        bubblePos.m_x += position.x;
-        bubblePos.m_y += position.y;
-        
-        // Temporarily set the bubble's position to the adjusted position
-        bubble->SetPosition(bubblePos);
-        
-        // Draw the bubble
-        bubble->Draw(graphics);
-        
-        // Restore the original position 
-        bubble->SetPosition(originalPos);
-    }
+    // Bubbles are in component coordinates, so offset them by our position
+    mBubbles.Draw(graphics, mBubbleSprite.get(), position);
 }
 
 /**
- * Update the bubble blower and its bubbles
- * @param time Current time in seconds
+ * Advance the bubble blower and its bubbles by one simulation step
  */
-void BubbleBlower::Update(double time)
+void BubbleBlower::Update()
 {
-    // Create new bubbles
-    BlowBubbles(time);
+    Tracer::Scope trace("BubbleBlower::Update", "bubbles", (long long)mBubbles.GetCount());
+
+    // Create new bubbles for the amount we turned this step
+    BlowBubbles(GetRotationRate() / StepsPerSecond);
     
-    // Remove bubbles that have gone far off-screen or popped
-    auto iter = mBubbles.begin();
-    while (iter != mBubbles.end())
+    for (int step = 0; step < BubbleStepsPerUpdate; step++)
     {
-        auto bubble = *iter;
-        bubble->Update(time);
-        
-        auto pos = bubble->GetPosition();
-        bool shouldRemove = false;
-        
-        // Check if bubble is popped
-        if (bubble->HasPopped())
-        {
-            shouldRemove = true;
-        }
-        // Only remove bubbles when they are very far off screen
-        else if (pos.m_y > 600 || pos.m_y < -600 || 
-            pos.m_x > 800 || pos.m_x < -800)
-        {
-            shouldRemove = true;
-        }
-        
-        if (shouldRemove)
-        {
-            iter = mBubbles.erase(iter);
-        }
-        else
-        {
-            ++iter;
-        }
+        mBubbles.Update(1.0 / StepsPerSecond);
     }
+    
+    // Remove bubbles that have gone far off-screen or popped
+    mBubbles.Cull();
 }
 
 /**
@@ -125,15 +99,129 @@ void BubbleBlower::SetTime(double time)
 {
     Component::SetTime(time);
     
+    // The snapshots are only good for the rate they were simulated at
+    if (GetRotationRate() != mSimulationRate)
+    {
+        Reset();
+    }
+    
     // Only create bubbles when time is positive (after start button is clicked)
-    if (time > 0)
+    int step = time > 0 ? int(time * StepsPerSecond + 0.5) : 0;
+    SeekStep(step);
+}
+
+/**
+ * Set the seed for the bubble simulation
+ *
+ * Two blowers with the same seed and rotation produce the same bubbles.
+ * @param seed Seed value
+ */
+void BubbleBlower::SetSeed(unsigned int seed)
+{
+    mSeed = seed;
+    Reset();
+}
+
+/**
+ * Restart the simulation from the seed, discarding all snapshots
+ */
+void BubbleBlower::Reset()
+{
+    mRandom.seed(mSeed);
+    mBubbles.Clear();
+    mAccumulatedRotation = 0;
+    mStep = 0;
+    mSimulationRate = GetRotationRate();
+    
+    // Step 0 is always the first snapshot
+    mSnapshots.clear();
+    mSnapshotInterval = SnapshotInterval;
+    SaveSnapshot();
+}
+
+/**
+ * Save the current simulation state as a snapshot
+ */
+void BubbleBlower::SaveSnapshot()
+{
+    Snapshot snapshot;
+    snapshot.mRandom = mRandom;
+    snapshot.mAccumulatedRotation = mAccumulatedRotation;
+    snapshot.mBubbles = mBubbles;
+    
+    mSnapshots.push_back(snapshot);
+    
+    if (mSnapshots.size() > MaxSnapshots)
     {
-        // Update the component at this time step
-        Update(time);
+        ThinSnapshots();
+    }
+}
+
+/**
+ * Drop every other snapshot and double the snapshot interval
+ *
+ * The snapshots that remain are at multiples of the new interval,
+ * so entry i is still the state at step i * mSnapshotInterval.
+ */
+void BubbleBlower::ThinSnapshots()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < mSnapshots.size(); i += 2)
+    {
+        if (kept != i)
+        {
+            mSnapshots[kept] = std::move(mSnapshots[i]);
+        }
+        kept++;
     }
     
-    // Store previous rotation for next update
-    mPreviousRotation = GetCurrentRotation();
+    mSnapshots.resize(kept);
+    mSnapshotInterval *= 2;
+}
+
+/**
+ * Restore the simulation state from a snapshot
+ * @param index Index of the snapshot in mSnapshots
+ */
+void BubbleBlower::RestoreSnapshot(size_t index)
+{
+    auto& snapshot = mSnapshots[index];
+    mRandom = snapshot.mRandom;
+    mAccumulatedRotation = snapshot.mAccumulatedRotation;
+    
+    // Assignment reuses the storage we already have
+    mBubbles = snapshot.mBubbles;
+    
+    mStep = int(index) * mSnapshotInterval;
+}
+
+/**
+ * Bring the simulation to a step
+ *
+ * Going backwards, or jumping forward past a snapshot, restores the
+ * nearest snapshot at or before the step and simulates from there.
+ * @param step Step to simulate to
+ */
+void BubbleBlower::SeekStep(int step)
+{
+    size_t nearest = std::min(size_t(step / mSnapshotInterval), mSnapshots.size() - 1);
+    int nearestStep = int(nearest) * mSnapshotInterval;
+    if (step < mStep || nearestStep > mStep)
+    {
+        RestoreSnapshot(nearest);
+    }
+    
+    while (mStep < step)
+    {
+        Update();
+        mStep++;
+        
+        // Snapshots are taken once, the first time we reach them
+        if (mStep % mSnapshotInterval == 0 && size_t(mStep / mSnapshotInterval) == mSnapshots.size())
+        {
+            SaveSnapshot();
+        }
+    }
 }
 
 /**
@@ -167,38 +255,17 @@ void BubbleBlower::CreateBubble()
     // Faster initial velocity for quicker movement
     wxPoint2DDouble bubbleVelocity((float)(dx1 * velocity), (float)(dy1 * velocity));
     
-    // Create a new bubble
-    auto bubble = std::make_shared<Bubble>();
-    bubble->SetPosition(bubblePosition);
-    bubble->SetVelocity(bubbleVelocity);
-    
-    // Set the bubble image
-    if (!mImageDirectory.empty())
-    {
-        std::wstring imagePath = mImageDirectory + L"/bubble.png";
-        bubble->SetImage(imagePath);
-    }
-    else
-    {
-        // Force red color for visibility if no image
-        bubble->GetImage()->SetColor(wxColor(255, 0, 0, 255));
-    }
-    
-    // Add to collection
-    AddBubble(bubble);
+    // Add the bubble, keyed from our generator so the
+    // simulation stays repeatable
+    mBubbles.Add(bubblePosition, bubbleVelocity, mRandom());
 }
 
 /**
- * Blow bubbles based on the current time
- * @param time Current time in seconds
+ * Blow bubbles based on how far the blower has turned
+ * @param rotation Rotation in radians since the last step
  */
-void BubbleBlower::BlowBubbles(double time)
+void BubbleBlower::BlowBubbles(double rotation)
 {
-    // Calculate rotation for bubble generation
-    double currentRotation = GetCurrentRotation();
-    double rotation = currentRotation - mPreviousRotation;
-    mPreviousRotation = currentRotation;
-    
     // Prevent negative rotation (which can happen with direction changes)
     if (rotation < 0)
     {
@@ -209,8 +276,7 @@ void BubbleBlower::BlowBubbles(double time)
     rotation *= 3.0;  // Triple the rotation value for better bubble creation rate
 
     // Keep track of accumulated rotation to handle small movements
-    static double accumulatedRotation = 0;
-    accumulatedRotation += rotation;
+    mAccumulatedRotation += rotation;
 
     // Compute bubbles to generate
     // Each bubble should be created after 1/5 of a rotation
@@ -219,10 +285,10 @@ void BubbleBlower::BlowBubbles(double time)
     // Calculate how many bubbles to create based on accumulated rotation
     int num = 0;
     
-    if (accumulatedRotation >= rotationPerBubble)
+    if (mAccumulatedRotation >= rotationPerBubble)
     {
         // Calculate number of bubbles to create - exactly 5 per rotation
-        num = int(accumulatedRotation * BubblePerRotation);
+        num = int(mAccumulatedRotation * BubblePerRotation);
         
         // Cap the maximum number of bubbles created at once to prevent bursts
         if (num > 3)
@@ -231,7 +297,7 @@ void BubbleBlower::BlowBubbles(double time)
         }
         
         // Subtract the used rotation amount, but keep remainders for next time
-        accumulatedRotation -= (num / BubblePerRotation);
+        mAccumulatedRotation -= (num / BubblePerRotation);
     }
     
     // Create the bubbles
@@ -242,12 +308,23 @@ void BubbleBlower::BlowBubbles(double time)
 }
 
 /**
- * Add a bubble to the bubble blower
- * @param bubble Bubble to add
+ * Set the image directory for bubble images
+ * @param directory Directory path for images
  */
-void BubbleBlower::AddBubble(std::shared_ptr<Bubble> bubble)
+void BubbleBlower::SetImageDirectory(const std::wstring& directory)
 {
-    mBubbles.push_back(bubble);
+    mImageDirectory = directory;
+    
+    std::wstring imagePath = mImageDirectory + L"/bubble.png";
+    wxFileName file(imagePath);
+    if (!file.FileExists())
+    {
+        // Use a bright color if image can't be found
+        mBubbleSprite->SetColor(wxColor(255, 0, 0, 200));
+        return;
+    }
+    
+    mBubbleSprite->SetImage(imagePath);
 }
 
 /**
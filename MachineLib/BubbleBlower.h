@@ -11,22 +11,46 @@
 #include "Component.h"
 #include "Sink.h"
 #include <memory>
-#include <list>
+#include <vector>
 #include <random>
-
-// Forward references
-class Bubble;
+#include "BubbleParticles.h"
 
 /**
  * Class for a bubble blower
+ *
+ * The bubbles are simulated in fixed steps from a seed, so the
+ * same time always produces the same bubbles. Snapshots of the
+ * simulation are kept at a regular interval so a seek only has to
+ * simulate forward from the nearest snapshot. When there are more
+ * than MaxSnapshots, every other one is dropped and the interval
+ * doubles, so memory stays bounded however long the machine runs.
+ *
+ * The bubbles themselves live in a BubbleParticles store and are
+ * all drawn with one shared sprite.
  */
 class BubbleBlower : public Component {
 private:
+    /// Saved state of the bubble simulation at one step
+    struct Snapshot
+    {
+        /// Random number generator state
+        std::mt19937 mRandom;
+
+        /// Rotation not yet turned into bubbles
+        double mAccumulatedRotation;
+
+        /// Copy of the live bubbles
+        BubbleParticles mBubbles;
+    };
+
     /// The bubble rate (bubbles per rotation)
     double mBubbleRate = 5.0;
     
-    /// Collection of bubbles managed by this machine
-    std::list<std::shared_ptr<Bubble>> mBubbles;
+    /// Bubbles managed by this machine
+    BubbleParticles mBubbles;
+    
+    /// Polygon drawn for every bubble
+    std::shared_ptr<cse335::Polygon> mBubbleSprite;
     
     /// The sink for receiving rotation
     std::shared_ptr<Sink> mSink;
@@ -34,8 +58,32 @@ private:
     /// Random number generator
     std::mt19937 mRandom;
     
-    /// Previous rotation value
-    double mPreviousRotation = 0;
+    /// Seed for the random number generator
+    unsigned int mSeed = 0;
+    
+    /// Simulation step the bubbles are currently at
+    int mStep = 0;
+    
+    /// Rotation not yet turned into bubbles
+    double mAccumulatedRotation = 0;
+    
+    /// Rotation rate the snapshots were simulated with
+    double mSimulationRate = 0;
+    
+    /// Snapshots of the simulation. Entry i is the state at step i * mSnapshotInterval
+    std::vector<Snapshot> mSnapshots;
+    
+    /// Number of simulation steps between the snapshots we have
+    int mSnapshotInterval = SnapshotInterval;
+    
+    /// Simulation steps per second of machine time
+    static const int StepsPerSecond = 30;
+    
+    /// Number of simulation steps between snapshots when the simulation starts
+    static const int SnapshotInterval = 30;
+    
+    /// Most snapshots we keep before thinning them out
+    static const size_t MaxSnapshots = 64;
     
     /// Width of the bubble blower in pixels
     static const int BubbleBlowerWidth = 50;
@@ -72,6 +120,33 @@ private:
     
     /// Image directory path for loading bubble image
     std::wstring mImageDirectory;
+    
+    /**
+     * Restart the simulation from the seed, discarding all snapshots
+     */
+    void Reset();
+    
+    /**
+     * Save the current simulation state as a snapshot
+     */
+    void SaveSnapshot();
+    
+    /**
+     * Drop every other snapshot and double the snapshot interval
+     */
+    void ThinSnapshots();
+    
+    /**
+     * Restore the simulation state from a snapshot
+     * @param index Index of the snapshot in mSnapshots
+     */
+    void RestoreSnapshot(size_t index);
+    
+    /**
+     * Bring the simulation to a step
+     * @param step Step to simulate to
+     */
+    void SeekStep(int step);
 
 public:
     BubbleBlower();
@@ -90,28 +165,21 @@ public:
     void SetTime(double time) override;
     
     /**
-     * Update the bubble blower and its bubbles
-     * @param time Current time in seconds
+     * Advance the bubble blower and its bubbles by one simulation step
      */
-    void Update(double time);
+    void Update();
     
     /**
-     * Blow bubbles based on the current time
-     * @param time Current time in seconds
+     * Blow bubbles based on how far the blower has turned
+     * @param rotation Rotation in radians since the last step
      */
-    void BlowBubbles(double time);
+    void BlowBubbles(double rotation);
     
     /**
      * Create a single bubble with randomized parameters
      */
     void CreateBubble();
     
-    /**
-     * Add a bubble to the bubble blower
-     * @param bubble Bubble to add
-     */
-    void AddBubble(std::shared_ptr<Bubble> bubble);
-    
     /**
      * Test if a point is within the bubble blower
      * @param pos Position to test
@@ -149,7 +217,45 @@ public:
      * Set the image directory for bubble images
      * @param directory Directory path for images
      */
-    void SetImageDirectory(const std::wstring& directory) { mImageDirectory = directory; }
+    void SetImageDirectory(const std::wstring& directory);
+    
+    /**
+     * Set the seed for the bubble simulation
+     *
+     * Two blowers with the same seed and rotation produce the same bubbles.
+     * @param seed Seed value
+     */
+    void SetSeed(unsigned int seed);
+    
+    /**
+     * Get the seed for the bubble simulation
+     * @return Seed value
+     */
+    unsigned int GetSeed() const { return mSeed; }
+    
+    /**
+     * Get the simulation step the bubbles are at
+     * @return Step number
+     */
+    int GetStep() const { return mStep; }
+    
+    /**
+     * Get the number of snapshots kept for seeking
+     * @return Number of snapshots
+     */
+    size_t GetSnapshotCount() const { return mSnapshots.size(); }
+    
+    /**
+     * Get the number of live bubbles
+     * @return Number of bubbles
+     */
+    size_t GetBubbleCount() const { return mBubbles.GetCount(); }
+    
+    /**
+     * Get the bubbles
+     * @return Bubble store
+     */
+    const BubbleParticles& GetBubbles() const { return mBubbles; }
 };
 
 #endif //BUBBLEBLOWER_H 
\ No newline at end of file
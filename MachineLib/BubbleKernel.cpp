@@ -0,0 +1,364 @@
+/**
+ * @file BubbleKernel.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "BubbleKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BUBBLE_KERNEL_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(BUBBLE_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+/// Compile a function for AVX2 without enabling it for the whole file
+#define BUBBLE_KERNEL_AVX2 __attribute__((target("avx2")))
+#else
+/// MSVC allows AVX2 intrinsics without any attribute
+#define BUBBLE_KERNEL_AVX2
+#endif
+
+/// Golden ratio constant used to spread the step counter over all bits
+const uint32_t CounterSpread = 0x9e3779b9;
+
+/**
+ * Integer hash (Thomas Wang's 32 bit shift hash). It only uses
+ * shifts, adds and xors, so it maps directly onto SSE2 and AVX2.
+ * @param key Value to hash
+ * @return Hashed value
+ */
+static inline uint32_t Hash(uint32_t key)
+{
+    key = ~key + (key << 15);
+    key = key ^ (key >> 12);
+    key = key + (key << 2);
+    key = key ^ (key >> 4);
+    key = key + (key << 3) + (key << 11);
+    key = key ^ (key >> 16);
+    return key;
+}
+
+/**
+ * Compute the 24 bit random number for a key and step counter
+ * @param key Bubble key
+ * @param counter Step counter
+ * @return Random number in [0, 2^24)
+ */
+int32_t BubbleKernel::Random(uint32_t key, uint32_t counter)
+{
+    return int32_t(Hash(key ^ (counter * CounterSpread)) >> 8);
+}
+
+/**
+ * Update a range of bubbles one at a time
+ * @param data Bubble arrays
+ * @param step Values for this step
+ * @param start First bubble to update
+ */
+static void UpdateScalar(const BubbleKernelData& data, const BubbleKernelStep& step, size_t start)
+{
+    uint32_t mix = step.mCounter * CounterSpread;
+
+    for (size_t i = start; i < data.mCount; i++)
+    {
+        data.mVelocityY[i] += step.mGravity;
+        data.mX[i] += data.mVelocityX[i] * step.mElapsed;
+        data.mY[i] += data.mVelocityY[i] * step.mElapsed;
+
+        int32_t alive = data.mAlive[i];
+
+        int32_t random = int32_t(Hash(data.mKey[i] ^ mix) >> 8);
+        if (random < step.mExpansionThreshold && alive)
+        {
+            data.mRadius[i] += step.mExpansionAmount;
+        }
+
+        if (data.mRadius[i] > step.mMaximumRadius ||
+            data.mX[i] > step.mMaxX || data.mX[i] < -step.mMaxX ||
+            data.mY[i] > step.mMaxY || data.mY[i] < -step.mMaxY)
+        {
+            alive = 0;
+        }
+
+        data.mAlive[i] = alive;
+    }
+}
+
+#ifdef BUBBLE_KERNEL_X86
+
+/**
+ * Wang hash on four lanes
+ * @param key Values to hash
+ * @return Hashed values
+ */
+static inline __m128i HashSSE2(__m128i key)
+{
+    key = _mm_add_epi32(_mm_xor_si128(key, _mm_set1_epi32(-1)), _mm_slli_epi32(key, 15));
+    key = _mm_xor_si128(key, _mm_srli_epi32(key, 12));
+    key = _mm_add_epi32(key, _mm_slli_epi32(key, 2));
+    key = _mm_xor_si128(key, _mm_srli_epi32(key, 4));
+    key = _mm_add_epi32(_mm_add_epi32(key, _mm_slli_epi32(key, 3)), _mm_slli_epi32(key, 11));
+    key = _mm_xor_si128(key, _mm_srli_epi32(key, 16));
+    return key;
+}
+
+/**
+ * Update bubbles four at a time with SSE2
+ * @param data Bubble arrays
+ * @param step Values for this step
+ */
+static void UpdateSSE2(const BubbleKernelData& data, const BubbleKernelStep& step)
+{
+    const __m128 elapsed = _mm_set1_ps(step.mElapsed);
+    const __m128 gravity = _mm_set1_ps(step.mGravity);
+    const __m128i mix = _mm_set1_epi32(int32_t(step.mCounter * CounterSpread));
+    const __m128i threshold = _mm_set1_epi32(step.mExpansionThreshold);
+    const __m128 amount = _mm_set1_ps(step.mExpansionAmount);
+    const __m128 maxRadius = _mm_set1_ps(step.mMaximumRadius);
+    const __m128 maxX = _mm_set1_ps(step.mMaxX);
+    const __m128 minX = _mm_set1_ps(-step.mMaxX);
+    const __m128 maxY = _mm_set1_ps(step.mMaxY);
+    const __m128 minY = _mm_set1_ps(-step.mMaxY);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 4 <= data.mCount; i += 4)
+    {
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(data.mVelocityY + i), gravity);
+        __m128 vx = _mm_loadu_ps(data.mVelocityX + i);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(data.mX + i), _mm_mul_ps(vx, elapsed));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(data.mY + i), _mm_mul_ps(vy, elapsed));
+
+        // All ones in lanes that are alive
+        __m128i alive = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(data.mAlive + i)), zero);
+
+        __m128i key = _mm_loadu_si128((const __m128i*)(data.mKey + i));
+        __m128i random = _mm_srli_epi32(HashSSE2(_mm_xor_si128(key, mix)), 8);
+        __m128 grow = _mm_castsi128_ps(_mm_and_si128(_mm_cmplt_epi32(random, threshold), alive));
+        __m128 radius = _mm_add_ps(_mm_loadu_ps(data.mRadius + i), _mm_and_ps(grow, amount));
+
+        __m128 dead = _mm_or_ps(_mm_cmpgt_ps(radius, maxRadius),
+            _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(x, maxX), _mm_cmplt_ps(x, minX)),
+                _mm_or_ps(_mm_cmpgt_ps(y, maxY), _mm_cmplt_ps(y, minY))));
+        alive = _mm_andnot_si128(_mm_castps_si128(dead), alive);
+
+        _mm_storeu_ps(data.mVelocityY + i, vy);
+        _mm_storeu_ps(data.mX + i, x);
+        _mm_storeu_ps(data.mY + i, y);
+        _mm_storeu_ps(data.mRadius + i, radius);
+        _mm_storeu_si128((__m128i*)(data.mAlive + i), _mm_and_si128(alive, one));
+    }
+
+    UpdateScalar(data, step, i);
+}
+
+/**
+ * Wang hash on eight lanes
+ * @param key Values to hash
+ * @return Hashed values
+ */
+BUBBLE_KERNEL_AVX2 static inline __m256i HashAVX2(__m256i key)
+{
+    key = _mm256_add_epi32(_mm256_xor_si256(key, _mm256_set1_epi32(-1)), _mm256_slli_epi32(key, 15));
+    key = _mm256_xor_si256(key, _mm256_srli_epi32(key, 12));
+    key = _mm256_add_epi32(key, _mm256_slli_epi32(key, 2));
+    key = _mm256_xor_si256(key, _mm256_srli_epi32(key, 4));
+    key = _mm256_add_epi32(_mm256_add_epi32(key, _mm256_slli_epi32(key, 3)), _mm256_slli_epi32(key, 11));
+    key = _mm256_xor_si256(key, _mm256_srli_epi32(key, 16));
+    return key;
+}
+
+/**
+ * Update bubbles eight at a time with AVX2
+ * @param data Bubble arrays
+ * @param step Values for this step
+ */
+BUBBLE_KERNEL_AVX2 static void UpdateAVX2(const BubbleKernelData& data, const BubbleKernelStep& step)
+{
+    const __m256 elapsed = _mm256_set1_ps(step.mElapsed);
+    const __m256 gravity = _mm256_set1_ps(step.mGravity);
+    const __m256i mix = _mm256_set1_epi32(int32_t(step.mCounter * CounterSpread));
+    const __m256i threshold = _mm256_set1_epi32(step.mExpansionThreshold);
+    const __m256 amount = _mm256_set1_ps(step.mExpansionAmount);
+    const __m256 maxRadius = _mm256_set1_ps(step.mMaximumRadius);
+    const __m256 maxX = _mm256_set1_ps(step.mMaxX);
+    const __m256 minX = _mm256_set1_ps(-step.mMaxX);
+    const __m256 maxY = _mm256_set1_ps(step.mMaxY);
+    const __m256 minY = _mm256_set1_ps(-step.mMaxY);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 8 <= data.mCount; i += 8)
+    {
+        __m256 vy = _mm256_add_ps(_mm256_loadu_ps(data.mVelocityY + i), gravity);
+        __m256 vx = _mm256_loadu_ps(data.mVelocityX + i);
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(data.mX + i), _mm256_mul_ps(vx, elapsed));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(data.mY + i), _mm256_mul_ps(vy, elapsed));
+
+        // All ones in lanes that are alive
+        __m256i alive = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(data.mAlive + i)), zero);
+
+        __m256i key = _mm256_loadu_si256((const __m256i*)(data.mKey + i));
+        __m256i random = _mm256_srli_epi32(HashAVX2(_mm256_xor_si256(key, mix)), 8);
+        __m256 grow = _mm256_castsi256_ps(_mm256_and_si256(_mm256_cmpgt_epi32(threshold, random), alive));
+        __m256 radius = _mm256_add_ps(_mm256_loadu_ps(data.mRadius + i), _mm256_and_ps(grow, amount));
+
+        __m256 dead = _mm256_or_ps(_mm256_cmp_ps(radius, maxRadius, _CMP_GT_OQ),
+            _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(x, maxX, _CMP_GT_OQ), _mm256_cmp_ps(x, minX, _CMP_LT_OQ)),
+                _mm256_or_ps(_mm256_cmp_ps(y, maxY, _CMP_GT_OQ), _mm256_cmp_ps(y, minY, _CMP_LT_OQ))));
+        alive = _mm256_andnot_si256(_mm256_castps_si256(dead), alive);
+
+        _mm256_storeu_ps(data.mVelocityY + i, vy);
+        _mm256_storeu_ps(data.mX + i, x);
+        _mm256_storeu_ps(data.mY + i, y);
+        _mm256_storeu_ps(data.mRadius + i, radius);
+        _mm256_storeu_si256((__m256i*)(data.mAlive + i), _mm256_and_si256(alive, one));
+    }
+
+    UpdateScalar(data, step, i);
+}
+
+/**
+ * Determine if the processor and operating system support AVX2
+ * @return true if AVX2 can be used
+ */
+static bool HasAVX2()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+    {
+        return false;
+    }
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif // BUBBLE_KERNEL_X86
+
+/**
+ * Determine if this processor can run a kernel type
+ * @param type Kernel type
+ * @return true if supported
+ */
+bool BubbleKernel::IsSupported(Type type)
+{
+    switch (type)
+    {
+    case Type::Scalar:
+        return true;
+
+#ifdef BUBBLE_KERNEL_X86
+    case Type::SSE2:
+        // Every processor that runs this program has SSE2
+        return true;
+
+    case Type::AVX2:
+    {
+        static const bool hasAVX2 = HasAVX2();
+        return hasAVX2;
+    }
+#endif
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * Get the fastest kernel type this processor supports
+ * @return Kernel type
+ */
+BubbleKernel::Type BubbleKernel::GetBestType()
+{
+    if (IsSupported(Type::AVX2))
+    {
+        return Type::AVX2;
+    }
+
+    if (IsSupported(Type::SSE2))
+    {
+        return Type::SSE2;
+    }
+
+    return Type::Scalar;
+}
+
+/**
+ * Get a readable name for a kernel type
+ * @param type Kernel type
+ * @return Name like "AVX2"
+ */
+const char* BubbleKernel::GetName(Type type)
+{
+    switch (type)
+    {
+    case Type::SSE2:
+        return "SSE2";
+
+    case Type::AVX2:
+        return "AVX2";
+
+    default:
+        return "Scalar";
+    }
+}
+
+/**
+ * Update every bubble by one step with the fastest supported kernel
+ * @param data Bubble arrays
+ * @param step Values for this step
+ */
+void BubbleKernel::Update(const BubbleKernelData& data, const BubbleKernelStep& step)
+{
+    static const Type best = GetBestType();
+    Update(best, data, step);
+}
+
+/**
+ * Update every bubble by one step with a given kernel type
+ * @param type Kernel type, which must be supported
+ * @param data Bubble arrays
+ * @param step Values for this step
+ */
+void BubbleKernel::Update(Type type, const BubbleKernelData& data, const BubbleKernelStep& step)
+{
+    switch (type)
+    {
+#ifdef BUBBLE_KERNEL_X86
+    case Type::SSE2:
+        UpdateSSE2(data, step);
+        break;
+
+    case Type::AVX2:
+        UpdateAVX2(data, step);
+        break;
+#endif
+
+    default:
+        UpdateScalar(data, step, 0);
+        break;
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file BubbleKernel.h
+ * @author Aditya Menon
+ *
+ * Batch update of bubble particles using SIMD instructions
+ */
+
+#ifndef BUBBLEKERNEL_H
+#define BUBBLEKERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Pointers to the arrays of a bubble store, all of the same length
+ */
+struct BubbleKernelData
+{
+    /// X position of each bubble
+    float* mX;
+
+    /// Y position of each bubble
+    float* mY;
+
+    /// X velocity of each bubble
+    float* mVelocityX;
+
+    /// Y velocity of each bubble
+    float* mVelocityY;
+
+    /// Radius of each bubble
+    float* mRadius;
+
+    /// Random number key of each bubble
+    const uint32_t* mKey;
+
+    /// 1 if the bubble is alive, 0 once it has popped or left the bounds
+    int32_t* mAlive;
+
+    /// Number of bubbles
+    size_t mCount;
+};
+
+/**
+ * Values shared by every bubble in one update step
+ */
+struct BubbleKernelStep
+{
+    /// Elapsed time in seconds
+    float mElapsed;
+
+    /// Change in Y velocity due to gravity this step
+    float mGravity;
+
+    /// Counter mixed with each key to make this step's random numbers
+    uint32_t mCounter;
+
+    /// A bubble expands when its 24 bit random number is below this
+    int32_t mExpansionThreshold;
+
+    /// Amount the radius increases on expansion
+    float mExpansionAmount;
+
+    /// Radius above which a bubble pops
+    float mMaximumRadius;
+
+    /// Largest distance from the origin allowed in X
+    float mMaxX;
+
+    /// Largest distance from the origin allowed in Y
+    float mMaxY;
+};
+
+/**
+ * Batch update of bubble particles.
+ *
+ * One step applies gravity, integrates position, rolls for
+ * expansion, pops bubbles that grow too large and marks bubbles
+ * outside the bounds as dead. The random number for a roll is a
+ * hash of the bubble's key and the step counter, so there is no
+ * generator state to carry from one step to the next and every
+ * lane can compute its number independently.
+ *
+ * The SSE2 version handles 4 bubbles per instruction and the AVX2
+ * version 8. The best version the processor supports is chosen at
+ * run time. All versions make the same random rolls, so they
+ * agree up to floating point rounding.
+ */
+class BubbleKernel {
+public:
+    /// Instruction sets the kernel is implemented with
+    enum class Type {Scalar, SSE2, AVX2};
+
+    /**
+     * Determine if this processor can run a kernel type
+     * @param type Kernel type
+     * @return true if supported
+     */
+    static bool IsSupported(Type type);
+
+    /**
+     * Get the fastest kernel type this processor supports
+     * @return Kernel type
+     */
+    static Type GetBestType();
+
+    /**
+     * Get a readable name for a kernel type
+     * @param type Kernel type
+     * @return Name like "AVX2"
+     */
+    static const char* GetName(Type type);
+
+    /**
+     * Update every bubble by one step with the fastest supported kernel
+     * @param data Bubble arrays
+     * @param step Values for this step
+     */
+    static void Update(const BubbleKernelData& data, const BubbleKernelStep& step);
+
+    /**
+     * Update every bubble by one step with a given kernel type
+     * @param type Kernel type, which must be supported
+     * @param data Bubble arrays
+     * @param step Values for this step
+     */
+    static void Update(Type type, const BubbleKernelData& data, const BubbleKernelStep& step);
+
+    /**
+     * Compute the 24 bit random number for a key and step counter
+     * @param key Bubble key
+     * @param counter Step counter
+     * @return Random number in [0, 2^24)
+     */
+    static int32_t Random(uint32_t key, uint32_t counter);
+};
+
+#endif //BUBBLEKERNEL_H
@@ -0,0 +1,173 @@
+/**
+ * @file BubbleParticles.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "BubbleParticles.h"
+#include "Polygon.h"
+#include "BubbleKernel.h"
+
+/// Gravity is very mild for soap bubbles (slower falling)
+const double Gravity = 1.0;
+
+// Initialize static constants
+const double BubbleParticles::BubbleExpansionProbability = 0.05;
+const int BubbleParticles::BubbleMaximumRadius = 30;
+const int BubbleParticles::BubbleInitialRadius = 15; // Starting radius
+const double BubbleParticles::BubbleExpansionAmount = 0.5; // How much radius increases each time
+
+/**
+ * Add a bubble
+ * @param position Position in pixels
+ * @param velocity Velocity in pixels per second
+ * @param key Key for the bubble's random numbers
+ */
+void BubbleParticles::Add(wxPoint2DDouble position, wxPoint2DDouble velocity, uint32_t key)
+{
+    mX.push_back(float(position.m_x));
+    mY.push_back(float(position.m_y));
+    mVelocityX.push_back(float(velocity.m_x));
+    mVelocityY.push_back(float(velocity.m_y));
+    mRadius.push_back(float(BubbleInitialRadius));
+    mKey.push_back(key);
+    mAlive.push_back(1);
+}
+
+/**
+ * Advance every bubble by one integration step
+ *
+ * Bubbles that pop or leave the bounds stay in the arrays,
+ * marked as dead, until the next Cull.
+ * @param elapsed Elapsed time in seconds
+ */
+void BubbleParticles::Update(double elapsed)
+{
+    BubbleKernelData data;
+    data.mX = mX.data();
+    data.mY = mY.data();
+    data.mVelocityX = mVelocityX.data();
+    data.mVelocityY = mVelocityY.data();
+    data.mRadius = mRadius.data();
+    data.mKey = mKey.data();
+    data.mAlive = mAlive.data();
+    data.mCount = mX.size();
+
+    BubbleKernelStep step;
+    step.mElapsed = float(elapsed);
+    step.mGravity = float(Gravity * elapsed);
+    step.mCounter = mCounter++;
+    step.mExpansionThreshold = int32_t(BubbleExpansionProbability * (1 << 24));
+    step.mExpansionAmount = float(BubbleExpansionAmount);
+    step.mMaximumRadius = float(BubbleMaximumRadius);
+    step.mMaxX = float(mMaxX);
+    step.mMaxY = float(mMaxY);
+
+    BubbleKernel::Update(data, step);
+}
+
+/**
+ * Remove bubbles that have popped or moved outside the bounds
+ */
+void BubbleParticles::Cull()
+{
+    size_t i = 0;
+    while (i < mX.size())
+    {
+        if (!mAlive[i])
+        {
+            // The last bubble moves into this slot, so test it next
+            SwapAndPop(i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+ * Remove a bubble by moving the last bubble into its slot
+ * @param index Index of the bubble to remove
+ */
+void BubbleParticles::SwapAndPop(size_t index)
+{
+    size_t last = mX.size() - 1;
+    if (index != last)
+    {
+        mX[index] = mX[last];
+        mY[index] = mY[last];
+        mVelocityX[index] = mVelocityX[last];
+        mVelocityY[index] = mVelocityY[last];
+        mRadius[index] = mRadius[last];
+        mKey[index] = mKey[last];
+        mAlive[index] = mAlive[last];
+    }
+
+    mX.pop_back();
+    mY.pop_back();
+    mVelocityX.pop_back();
+    mVelocityY.pop_back();
+    mRadius.pop_back();
+    mKey.pop_back();
+    mAlive.pop_back();
+}
+
+/**
+ * Draw every bubble with a shared sprite
+ *
+ * The sprite is a circle of BubbleInitialRadius centered on the
+ * origin. Each bubble scales it to its own radius.
+ * @param graphics Graphics context to draw on
+ * @param sprite Polygon drawn for each bubble
+ * @param offset Offset added to every bubble position
+ */
+void BubbleParticles::Draw(std::shared_ptr<wxGraphicsContext> graphics, cse335::Polygon* sprite, wxPoint offset)
+{
+    if (sprite == nullptr)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < mX.size(); i++)
+    {
+        double scale = mRadius[i] / BubbleInitialRadius;
+
+        graphics->PushState();
+        graphics->Translate(mX[i] + offset.x, mY[i] + offset.y);
+        graphics->Scale(scale, scale);
+        sprite->DrawPolygon(graphics, 0, 0);
+        graphics->PopState();
+    }
+}
+
+/**
+ * Remove all bubbles, keeping the storage for reuse, and
+ * restart the random numbers
+ */
+void BubbleParticles::Clear()
+{
+    mX.clear();
+    mY.clear();
+    mVelocityX.clear();
+    mVelocityY.clear();
+    mRadius.clear();
+    mKey.clear();
+    mAlive.clear();
+    mCounter = 0;
+}
+
+/**
+ * Reserve storage for a number of bubbles
+ * @param count Number of bubbles
+ */
+void BubbleParticles::Reserve(size_t count)
+{
+    mX.reserve(count);
+    mY.reserve(count);
+    mVelocityX.reserve(count);
+    mVelocityY.reserve(count);
+    mRadius.reserve(count);
+    mKey.reserve(count);
+    mAlive.reserve(count);
+}
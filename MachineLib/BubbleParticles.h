@@ -0,0 +1,158 @@
+/**
+ * @file BubbleParticles.h
+ * @author Aditya Menon
+ *
+ * Storage and simulation for the bubbles of a bubble blower
+ */
+
+#ifndef BUBBLEPARTICLES_H
+#define BUBBLEPARTICLES_H
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace cse335 {
+    class Polygon;
+}
+
+/**
+ * Storage and simulation for the bubbles of a bubble blower.
+ *
+ * Bubbles are kept as parallel arrays rather than one object per
+ * bubble, so an update walks contiguous memory. Removed bubbles are
+ * replaced by the last bubble (swap and pop) and the arrays keep
+ * their capacity, so slots are reused without allocating.
+ *
+ * The update itself is done by BubbleKernel, several bubbles at a
+ * time. Values are single precision so more of them fit in each
+ * SIMD register.
+ */
+class BubbleParticles {
+private:
+    /// X position of each bubble
+    std::vector<float> mX;
+
+    /// Y position of each bubble
+    std::vector<float> mY;
+
+    /// X velocity of each bubble
+    std::vector<float> mVelocityX;
+
+    /// Y velocity of each bubble
+    std::vector<float> mVelocityY;
+
+    /// Current radius of each bubble
+    std::vector<float> mRadius;
+
+    /// Random number key of each bubble
+    std::vector<uint32_t> mKey;
+
+    /// 1 if the bubble is alive, 0 once it has popped or left the bounds
+    std::vector<int32_t> mAlive;
+
+    /// Number of updates so far, mixed into the random numbers
+    uint32_t mCounter = 0;
+
+    /// Largest distance from the origin allowed in X
+    double mMaxX = 1e6;
+
+    /// Largest distance from the origin allowed in Y
+    double mMaxY = 1e6;
+
+    /**
+     * Remove a bubble by moving the last bubble into its slot
+     * @param index Index of the bubble to remove
+     */
+    void SwapAndPop(size_t index);
+
+public:
+    /// Probability of a bubble expanding
+    static const double BubbleExpansionProbability;
+
+    /// The maximum possible radius of a bubble, after which it pops
+    static const int BubbleMaximumRadius;
+
+    /// The initial radius of a new bubble
+    static const int BubbleInitialRadius;
+
+    /// The amount the radius increases on expansion
+    static const double BubbleExpansionAmount;
+
+    BubbleParticles() {}
+
+    /**
+     * Add a bubble
+     * @param position Position in pixels
+     * @param velocity Velocity in pixels per second
+     * @param key Key for the bubble's random numbers
+     */
+    void Add(wxPoint2DDouble position, wxPoint2DDouble velocity, uint32_t key);
+
+    /**
+     * Advance every bubble by one integration step
+     * @param elapsed Elapsed time in seconds
+     */
+    void Update(double elapsed);
+
+    /**
+     * Remove bubbles that have popped or moved outside the bounds
+     */
+    void Cull();
+
+    /**
+     * Set the box around the origin bubbles must stay inside
+     * @param maxX Largest distance from the origin allowed in X
+     * @param maxY Largest distance from the origin allowed in Y
+     */
+    void SetBounds(double maxX, double maxY) { mMaxX = maxX; mMaxY = maxY; }
+
+    /**
+     * Draw every bubble with a shared sprite
+     * @param graphics Graphics context to draw on
+     * @param sprite Polygon drawn for each bubble, sized for BubbleInitialRadius
+     * @param offset Offset added to every bubble position
+     */
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, cse335::Polygon* sprite, wxPoint offset);
+
+    /**
+     * Remove all bubbles, keeping the storage for reuse, and
+     * restart the random numbers
+     */
+    void Clear();
+
+    /**
+     * Reserve storage for a number of bubbles
+     * @param count Number of bubbles
+     */
+    void Reserve(size_t count);
+
+    /**
+     * Get the number of bubbles
+     * @return Number of bubbles
+     */
+    size_t GetCount() const { return mX.size(); }
+
+    /**
+     * Get the position of a bubble
+     * @param index Bubble index
+     * @return Position in pixels
+     */
+    wxPoint2DDouble GetPosition(size_t index) const { return wxPoint2DDouble(mX[index], mY[index]); }
+
+    /**
+     * Get the radius of a bubble
+     * @param index Bubble index
+     * @return Radius in pixels
+     */
+    double GetRadius(size_t index) const { return mRadius[index]; }
+
+    /**
+     * Determine if a bubble is alive
+     * @param index Bubble index
+     * @return false if the bubble popped or left the bounds since the last Cull
+     */
+    bool IsAlive(size_t index) const { return mAlive[index] != 0; }
+};
+
+#endif //BUBBLEPARTICLES_H
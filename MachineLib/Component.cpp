@@ -25,6 +25,31 @@ Component::~Component()
 {
 }
 
+/**
+ * Set whether the component is static. Only components
+ * nothing drives, or that draw unrotated, can be static.
+ * @param isStatic New static status
+ */
+void Component::SetStatic(bool isStatic)
+{
+    // Invalidate both when the component leaves and joins the layer
+    StaticChanged();
+    mStatic = isStatic;
+    StaticChanged();
+}
+
+/**
+ * Tell the machine a static component has changed how it
+ * is drawn, so its static layer is drawn again
+ */
+void Component::StaticChanged()
+{
+    if (mStatic && mMachine != nullptr)
+    {
+        mMachine->InvalidateStaticLayer();
+    }
+}
+
 /**
  * Set the machine this component is associated with
  * @param machine Machine pointer
@@ -121,6 +146,7 @@ bool Component::HitTest(wxPoint pos)
 void Component::SetPosition(int x, int y)
 {
     mPosition = wxPoint(x, y);
+    StaticChanged();
 }
 
 /**
@@ -130,6 +156,7 @@ void Component::SetPosition(int x, int y)
 void Component::SetPosition(wxPoint position)
 {
     mPosition = position;
+    StaticChanged();
 }
 
 /**
@@ -144,6 +171,7 @@ void Component::Rectangle(int x, int y, int width, int height)
     if (mBase != nullptr)
     {
         mBase->Rectangle(x, y, width, height);
+        StaticChanged();
     }
 }
 
@@ -156,6 +184,7 @@ void Component::SetImage(const std::wstring& filename)
     if (mBase != nullptr)
     {
         mBase->SetImage(filename);
+        StaticChanged();
     }
 }
 
@@ -166,6 +195,7 @@ void Component::SetImage(const std::wstring& filename)
 void Component::SetPhase(double phase)
 {
     mPhase = phase;
+    StaticChanged();
 }
 
 /**
@@ -175,6 +205,7 @@ void Component::SetPhase(double phase)
 void Component::Place(wxPoint offset)
 {
     mPosition = offset;
+    StaticChanged();
 }
 
 /**
@@ -190,6 +221,8 @@ bool Component::SetComponentImage(const std::wstring& imagePath, wxColour defaul
         return false;
     }
     
+    StaticChanged();
+    
     // First check if file exists
     if (wxFileExists(imagePath))
     {
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 // Forward references
 class Machine;
@@ -45,6 +46,19 @@ private:
     
     /// Phase offset for rotation
     double mPhase = 0;
+    
+    /// Rate this component is driven at in radians per second
+    double mRotationRate = 0;
+    
+    /// Is this component drawn the same at every time?
+    bool mStatic = false;
+
+protected:
+    /**
+     * Tell the machine a static component has changed how it
+     * is drawn, so its static layer is drawn again
+     */
+    void StaticChanged();
 
 public:
     Component();
@@ -93,12 +107,50 @@ public:
      */
     double GetCurrentRotation() const { return mCurrentRotation; }
     
+    /**
+     * Get the components this component drives
+     * @return Driven components (empty if this component drives nothing)
+     */
+    virtual std::vector<Component*> GetDrivenComponents() { return {}; }
+    
+    /**
+     * Get the factor applied to rotation this component receives from its driver
+     * @return Speed multiplier (1.0 = same speed as the driver)
+     */
+    virtual double GetSpeedMultiplier() const { return 1.0; }
+    
+    /**
+     * Set the rate this component is driven at
+     * @param rate Rotation rate in radians per second
+     */
+    void SetRotationRate(double rate) { mRotationRate = rate; }
+    
+    /**
+     * Get the rate this component is driven at
+     * @return Rotation rate in radians per second (0 if not driven)
+     */
+    virtual double GetRotationRate() const { return mRotationRate; }
+    
     /**
      * Get the machine this component is associated with
      * @return Machine pointer
      */
     Machine* GetMachine();
     
+    /**
+     * Component is static, so it is drawn the same at every time
+     * and the machine can draw it from a cached layer
+     * @return true if component is static
+     */
+    bool IsStatic() const { return mStatic; }
+    
+    /**
+     * Set whether the component is static. Only components
+     * nothing drives, or that draw unrotated, can be static.
+     * @param isStatic New static status
+     */
+    void SetStatic(bool isStatic);
+    
     /**
      * Test if a point is within this component
      * @param pos Position to test
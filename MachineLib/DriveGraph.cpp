@@ -0,0 +1,234 @@
+/**
+ * @file DriveGraph.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "DriveGraph.h"
+#include "Component.h"
+#include "Motor.h"
+#include <deque>
+
+/**
+ * Find or add a component as a node of the graph
+ * @param component Component to add
+ * @param indices Map from component to node index
+ * @return Index of the node for this component
+ */
+size_t DriveGraph::AddNode(Component* component, std::map<Component*, size_t>& indices)
+{
+    auto found = indices.find(component);
+    if (found != indices.end())
+    {
+        return found->second;
+    }
+
+    size_t index = mNodes.size();
+    mNodes.push_back(component);
+    mEdges.emplace_back();
+    indices[component] = index;
+    return index;
+}
+
+/**
+ * Build the graph from the connections between components
+ *
+ * Components are sorted so every driving component comes before
+ * the components it drives. When a component has more than one
+ * driver, the driver that comes last in that order determines
+ * its rotation, which is the same result the old repeated passes
+ * converged to.
+ *
+ * @param components The components of the machine in drawing order
+ * @return true if the graph is free of cycles
+ */
+bool DriveGraph::Compile(const std::vector<std::shared_ptr<Component>>& components)
+{
+    mNodes.clear();
+    mEdges.clear();
+    mOrder.clear();
+    mRates.clear();
+    mDriven.clear();
+    mFixedRotations.clear();
+    mCycleCount = 0;
+
+    std::map<Component*, size_t> indices;
+
+    // Every machine component is a node, even if nothing drives it,
+    // so it still gets its time set during evaluation
+    for (auto& component : components)
+    {
+        if (component != nullptr)
+        {
+            AddNode(component.get(), indices);
+        }
+    }
+
+    // Walk the connections. Driven components may be added as we go,
+    // so this loop must not use iterators into mNodes.
+    for (size_t i = 0; i < mNodes.size(); i++)
+    {
+        for (auto driven : mNodes[i]->GetDrivenComponents())
+        {
+            if (driven == nullptr)
+            {
+                continue;
+            }
+
+            size_t target = AddNode(driven, indices);
+            mEdges[i].push_back({target, driven->GetSpeedMultiplier()});
+        }
+    }
+
+    //
+    // Topological sort (Kahn's algorithm). Ready components are
+    // taken in the order they were added so the result is stable.
+    //
+    std::vector<int> inDegree(mNodes.size(), 0);
+    for (auto& edges : mEdges)
+    {
+        for (auto& edge : edges)
+        {
+            inDegree[edge.mTarget]++;
+        }
+    }
+
+    std::deque<size_t> ready;
+    for (size_t i = 0; i < mNodes.size(); i++)
+    {
+        if (inDegree[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    std::vector<bool> placed(mNodes.size(), false);
+    while (!ready.empty())
+    {
+        size_t index = ready.front();
+        ready.pop_front();
+
+        mOrder.push_back(index);
+        placed[index] = true;
+
+        for (auto& edge : mEdges[index])
+        {
+            if (--inDegree[edge.mTarget] == 0)
+            {
+                ready.push_back(edge.mTarget);
+            }
+        }
+    }
+
+    // Anything left over is part of a cycle. Keep those components
+    // at the end so they are still updated, just not synchronized.
+    for (size_t i = 0; i < mNodes.size(); i++)
+    {
+        if (!placed[i])
+        {
+            mOrder.push_back(i);
+            mCycleCount++;
+        }
+    }
+
+    ComputeRates();
+
+    return mCycleCount == 0;
+}
+
+/**
+ * Compute the rotation rate of every component
+ *
+ * Motors set the rate of everything downstream of them. Each
+ * connection scales the rate by the gain of the driven component.
+ */
+void DriveGraph::ComputeRates()
+{
+    size_t count = mNodes.size();
+    mRates.assign(count, 0);
+    mDriven.assign(count, false);
+    mFixedRotations.assign(count, 0);
+
+    std::vector<bool> isMotor(count, false);
+    for (size_t i = 0; i < count; i++)
+    {
+        mFixedRotations[i] = mNodes[i]->GetCurrentRotation();
+
+        auto motor = dynamic_cast<Motor*>(mNodes[i]);
+        if (motor != nullptr)
+        {
+            isMotor[i] = true;
+            mDriven[i] = true;
+            mRates[i] = motor->GetRotationRate();
+        }
+    }
+
+    // In evaluation order every driver is final before it is used
+    for (auto index : mOrder)
+    {
+        if (!mDriven[index])
+        {
+            continue;
+        }
+
+        for (auto& edge : mEdges[index])
+        {
+            // A motor always turns at its own rate
+            if (!isMotor[edge.mTarget])
+            {
+                mRates[edge.mTarget] = mRates[index] * edge.mGain;
+                mDriven[edge.mTarget] = true;
+            }
+        }
+    }
+
+    // Let components that simulate in steps know their rate.
+    // Components that are not driven get a rate of zero.
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!isMotor[i])
+        {
+            mNodes[i]->SetRotationRate(mRates[i]);
+        }
+    }
+}
+
+/**
+ * Update every component in the graph for a time in a single pass
+ * @param time Machine time in seconds
+ */
+void DriveGraph::Evaluate(double time)
+{
+    for (auto index : mOrder)
+    {
+        auto component = mNodes[index];
+
+        // Rotation comes straight from the cached rate, so
+        // nothing has to be passed from driver to driven
+        if (mDriven[index])
+        {
+            component->SetCurrentRotation(mRates[index] * time);
+        }
+
+        component->SetTime(time);
+    }
+}
+
+/**
+ * Compute the rotation of every component at a time without
+ * changing any component. Safe to call from several threads.
+ *
+ * The cost is the same at any time, so seeking far into an
+ * animation costs no more than stepping to the next frame.
+ *
+ * @param time Machine time in seconds
+ * @param rotations Filled with one rotation in radians per node
+ */
+void DriveGraph::EvaluateRotations(double time, std::vector<double>& rotations) const
+{
+    rotations.resize(mNodes.size());
+    for (size_t i = 0; i < mNodes.size(); i++)
+    {
+        rotations[i] = mDriven[i] ? mRates[i] * time : mFixedRotations[i];
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * @file DriveGraph.h
+ * @author Aditya Menon
+ *
+ * Compiled graph of the rotation connections in a machine
+ */
+
+#ifndef DRIVEGRAPH_H
+#define DRIVEGRAPH_H
+
+#include <memory>
+#include <vector>
+#include <map>
+
+// Forward references
+class Component;
+
+/**
+ * Compiled graph of the rotation connections in a machine.
+ *
+ * The graph is built once from the connections made with
+ * Motor::AddSink, Pulley::ConnectBelt, Pulley::ConnectPulley
+ * and Source::AddSink. The components are sorted so that every
+ * component comes after the components that drive it.
+ *
+ * Since every rotation starts at a motor turning at a constant
+ * rate and is only scaled along the way, the compiled graph keeps
+ * a rotation rate for each driven component. The rotation at any
+ * time is then that rate times the time, with no propagation.
+ */
+class DriveGraph {
+private:
+    /// An edge from a driving component to a driven component
+    struct Edge
+    {
+        /// Index of the driven component in mNodes
+        size_t mTarget;
+
+        /// Factor applied to the rotation crossing this edge
+        double mGain;
+    };
+
+    /// All components in the graph
+    std::vector<Component*> mNodes;
+
+    /// Edges leaving each component, indexed the same as mNodes
+    std::vector<std::vector<Edge>> mEdges;
+
+    /// Component indices in evaluation order
+    std::vector<size_t> mOrder;
+
+    /// Number of components that are part of a drive cycle
+    size_t mCycleCount = 0;
+
+    /// Rotation rate of each component in radians per second
+    std::vector<double> mRates;
+
+    /// Whether each component's rotation is driven by a motor
+    std::vector<bool> mDriven;
+
+    /// Rotation of components that are not driven, captured when compiled
+    std::vector<double> mFixedRotations;
+
+    /**
+     * Compute the rotation rate of every component
+     */
+    void ComputeRates();
+
+    /**
+     * Find or add a component as a node of the graph
+     * @param component Component to add
+     * @param indices Map from component to node index
+     * @return Index of the node for this component
+     */
+    size_t AddNode(Component* component, std::map<Component*, size_t>& indices);
+
+public:
+    DriveGraph() {}
+
+    /// Copy constructor (disabled)
+    DriveGraph(const DriveGraph &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const DriveGraph &) = delete;
+
+    /**
+     * Build the graph from the connections between components
+     * @param components The components of the machine in drawing order
+     * @return true if the graph is free of cycles
+     */
+    bool Compile(const std::vector<std::shared_ptr<Component>>& components);
+
+    /**
+     * Update every component in the graph for a time in a single pass
+     * @param time Machine time in seconds
+     */
+    void Evaluate(double time);
+
+    /**
+     * Compute the rotation of every component at a time without
+     * changing any component. Safe to call from several threads.
+     * @param time Machine time in seconds
+     * @param rotations Filled with one rotation in radians per node
+     */
+    void EvaluateRotations(double time, std::vector<double>& rotations) const;
+
+    /**
+     * Get a component in the graph
+     * @param index Node index, the same index used by EvaluateRotations
+     * @return Component pointer
+     */
+    Component* GetNode(size_t index) const { return mNodes[index]; }
+
+    /**
+     * Get the number of components that are part of a drive cycle
+     * @return Number of components in cycles (0 if the graph is acyclic)
+     */
+    size_t GetCycleCount() const { return mCycleCount; }
+
+    /**
+     * Get the number of components in the graph
+     * @return Number of components
+     */
+    size_t GetNodeCount() const { return mNodes.size(); }
+};
+
+#endif //DRIVEGRAPH_H
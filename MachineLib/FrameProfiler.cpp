@@ -0,0 +1,162 @@
+/**
+ * @file FrameProfiler.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "FrameProfiler.h"
+
+/// Display names of the phases, in the order of FrameProfiler::Phase
+static const wchar_t* PhaseNames[FrameProfiler::NumPhases] = {
+        L"SetAnimationTime",
+        L"GetKeyframe",
+        L"Place",
+        L"MachineSetTime",
+        L"DrawPolygon",
+        L"CreateBitmap"
+};
+
+/**
+ * Constructor, private so the only instance is the one from Get
+ */
+FrameProfiler::FrameProfiler()
+{
+    for (int i = 0; i < NumPhases; i++)
+    {
+        mCurrent[i] = 0;
+        mCurrentCalls[i] = 0;
+        mLastCalls[i] = 0;
+    }
+}
+
+/**
+ * Get the process-wide frame profiler
+ * @return The frame profiler
+ */
+FrameProfiler& FrameProfiler::Get()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+/**
+ * Get the display name of a phase
+ * @param phase Phase
+ * @return Name of the phase
+ */
+const wchar_t* FrameProfiler::GetName(Phase phase)
+{
+    return PhaseNames[int(phase)];
+}
+
+/**
+ * Add time to a phase of the current frame
+ * @param phase Phase
+ * @param duration Time spent
+ */
+void FrameProfiler::Add(Phase phase, std::chrono::steady_clock::duration duration)
+{
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    mCurrent[int(phase)].fetch_add(ns, std::memory_order_relaxed);
+    mCurrentCalls[int(phase)].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * End the current frame, moving its times into the rolling window
+ */
+void FrameProfiler::EndFrame()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (int i = 0; i < NumPhases; i++)
+    {
+        mHistory[i].push_back(mCurrent[i].exchange(0, std::memory_order_relaxed));
+        mLastCalls[i] = mCurrentCalls[i].exchange(0, std::memory_order_relaxed);
+
+        while (mHistory[i].size() > mWindow)
+        {
+            mHistory[i].pop_front();
+        }
+    }
+}
+
+/**
+ * Get the statistics for a phase over the rolling window
+ * @param phase Phase
+ * @return Statistics in milliseconds
+ */
+FrameProfiler::Stats FrameProfiler::GetStats(Phase phase) const
+{
+    std::vector<long long> times;
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto& history = mHistory[int(phase)];
+        times.assign(history.begin(), history.end());
+        stats.mCalls = mLastCalls[int(phase)];
+    }
+
+    if (times.empty())
+    {
+        return stats;
+    }
+
+    std::sort(times.begin(), times.end());
+
+    // Nearest-rank percentile: the smallest time at least
+    // the fraction p of the frames are no slower than
+    const double ToMs = 1e-6;
+    auto rank = [&times](double p) {
+        auto index = size_t(std::ceil(p * times.size()));
+        return times[std::max(index, size_t(1)) - 1];
+    };
+
+    stats.mMin = times.front() * ToMs;
+    stats.mMedian = rank(0.5) * ToMs;
+    stats.mP99 = rank(0.99) * ToMs;
+    return stats;
+}
+
+/**
+ * Get the number of frames currently in the rolling window
+ * @return Number of frames
+ */
+size_t FrameProfiler::GetFrameCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHistory[0].size();
+}
+
+/**
+ * Set the number of frames in the rolling window
+ * @param frames Number of frames, at least 1
+ */
+void FrameProfiler::SetWindow(size_t frames)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mWindow = std::max(frames, size_t(1));
+    for (auto& history : mHistory)
+    {
+        while (history.size() > mWindow)
+        {
+            history.pop_front();
+        }
+    }
+}
+
+/**
+ * Discard the current frame and the rolling window
+ */
+void FrameProfiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (int i = 0; i < NumPhases; i++)
+    {
+        mCurrent[i] = 0;
+        mCurrentCalls[i] = 0;
+        mLastCalls[i] = 0;
+        mHistory[i].clear();
+    }
+}
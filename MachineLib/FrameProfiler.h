@@ -0,0 +1,210 @@
+/**
+ * @file FrameProfiler.h
+ * @author Aditya Menon
+ *
+ * Times the phases of each displayed frame
+ */
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+/**
+ * Times the phases of each displayed frame.
+ *
+ * Code that makes up a phase of a frame declares a
+ * FrameProfiler::Scope at the top of the block. While the
+ * profiler is enabled, the time spent in every scope is added to
+ * the total for its phase. The view calls EndFrame once it has
+ * drawn, which moves the totals for that frame into a rolling
+ * window that the statistics are computed from.
+ *
+ * Phases may contain one another. Setting the animation time
+ * includes the keyframe and machine time phases, and drawing an
+ * image polygon includes creating its bitmap, so the phases do
+ * not add up to the frame time.
+ *
+ * Scopes may be used on any thread. When disabled a scope costs
+ * one atomic load.
+ */
+class FrameProfiler {
+public:
+    /// The phases of a frame that are timed
+    enum class Phase {
+        AnimationTime,  ///< Picture::SetAnimationTime
+        Keyframe,       ///< Actor::GetKeyframe
+        Place,          ///< Drawable::Place of each actor's root drawable
+        MachineTime,    ///< MachineSystem::SetTime
+        DrawPolygon,    ///< Polygon::DrawPolygon
+        CreateBitmap    ///< Bitmap creation in Polygon::DrawImagePolygon
+    };
+
+    /// Number of phases
+    static const int NumPhases = 6;
+
+    /// Default number of frames in the rolling window
+    static const size_t DefaultWindow = 120;
+
+    /// Statistics for one phase over the rolling window
+    struct Stats
+    {
+        /// Shortest frame time in milliseconds
+        double mMin = 0;
+
+        /// Median frame time in milliseconds
+        double mMedian = 0;
+
+        /// 99th percentile frame time in milliseconds
+        double mP99 = 0;
+
+        /// Number of times the phase ran in the last frame
+        int mCalls = 0;
+    };
+
+    /**
+     * Times a block of code as part of a phase
+     */
+    class Scope
+    {
+    private:
+        /// Phase this scope is part of
+        Phase mPhase;
+
+        /// True if the profiler was enabled when the scope began
+        bool mActive;
+
+        /// Time the scope began
+        std::chrono::steady_clock::time_point mStart;
+
+    public:
+        /**
+         * Constructor, starts timing if the profiler is enabled
+         * @param phase Phase this scope is part of
+         */
+        explicit Scope(Phase phase) : mPhase(phase), mActive(FrameProfiler::Get().IsEnabled())
+        {
+            if (mActive)
+            {
+                mStart = std::chrono::steady_clock::now();
+            }
+        }
+
+        /**
+         * Destructor, adds the time to the phase
+         */
+        ~Scope()
+        {
+            if (mActive)
+            {
+                FrameProfiler::Get().Add(mPhase, std::chrono::steady_clock::now() - mStart);
+            }
+        }
+
+        /// Copy constructor (disabled)
+        Scope(const Scope &) = delete;
+
+        /// Assignment operator (disabled)
+        void operator=(const Scope &) = delete;
+    };
+
+private:
+    /// True while timing
+    std::atomic<bool> mEnabled{false};
+
+    /// Time spent in each phase this frame in nanoseconds
+    std::atomic<long long> mCurrent[NumPhases];
+
+    /// Number of times each phase ran this frame
+    std::atomic<int> mCurrentCalls[NumPhases];
+
+    /// Time spent in each phase in recent frames in nanoseconds, oldest first
+    std::deque<long long> mHistory[NumPhases];
+
+    /// Number of times each phase ran in the last frame
+    int mLastCalls[NumPhases];
+
+    /// Number of frames in the rolling window
+    size_t mWindow = DefaultWindow;
+
+    /// Protects mHistory, mLastCalls and mWindow
+    mutable std::mutex mMutex;
+
+    /**
+     * Constructor, private so the only instance is the one from Get
+     */
+    FrameProfiler();
+
+public:
+    /// Copy constructor (disabled)
+    FrameProfiler(const FrameProfiler &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const FrameProfiler &) = delete;
+
+    /**
+     * Get the process-wide frame profiler
+     * @return The frame profiler
+     */
+    static FrameProfiler& Get();
+
+    /**
+     * Get the display name of a phase
+     * @param phase Phase
+     * @return Name of the phase
+     */
+    static const wchar_t* GetName(Phase phase);
+
+    /**
+     * Add time to a phase of the current frame
+     * @param phase Phase
+     * @param duration Time spent
+     */
+    void Add(Phase phase, std::chrono::steady_clock::duration duration);
+
+    /**
+     * End the current frame, moving its times into the rolling window
+     */
+    void EndFrame();
+
+    /**
+     * Get the statistics for a phase over the rolling window
+     * @param phase Phase
+     * @return Statistics in milliseconds
+     */
+    Stats GetStats(Phase phase) const;
+
+    /**
+     * Get the number of frames currently in the rolling window
+     * @return Number of frames
+     */
+    size_t GetFrameCount() const;
+
+    /**
+     * Set the number of frames in the rolling window
+     * @param frames Number of frames, at least 1
+     */
+    void SetWindow(size_t frames);
+
+    /**
+     * Discard the current frame and the rolling window
+     */
+    void Reset();
+
+    /**
+     * Start or stop timing. Stopping keeps the rolling window.
+     * @param enabled True to time the phases
+     */
+    void SetEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * Determine if the profiler is timing
+     * @return True if enabled
+     */
+    bool IsEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+};
+
+#endif //FRAMEPROFILER_H
@@ -0,0 +1,189 @@
+/**
+ * @file GraphicsResourceCache.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "GraphicsResourceCache.h"
+#include "FrameProfiler.h"
+
+/**
+ * Get the cache for this thread
+ * @return The graphics resource cache
+ */
+GraphicsResourceCache& GraphicsResourceCache::Get()
+{
+    static thread_local GraphicsResourceCache cache;
+    return cache;
+}
+
+/**
+ * Find a bitmap or path, creating it if it is not in the cache
+ * @param resources The bitmaps or the paths
+ * @param graphics Graphics context the resource will be drawn on
+ * @param owner Object the resource is made from
+ * @param variant Which of the resources made from the object
+ * @param create Function that creates the resource
+ * @return The resource
+ */
+template<class T>
+T GraphicsResourceCache::Find(std::map<Key, Resource<T>>& resources, std::shared_ptr<wxGraphicsContext> graphics,
+        const std::shared_ptr<const void>& owner, int variant, const std::function<T()>& create)
+{
+    Key key{graphics->GetRenderer(), owner.get(), variant};
+
+    auto found = resources.find(key);
+    if (found != resources.end())
+    {
+        // An object that is gone may have left its resources
+        // to a new object at the same address
+        if (!found->second.mOwner.expired())
+        {
+            mHits++;
+            return found->second.mResource;
+        }
+
+        resources.erase(found);
+    }
+
+    mMisses++;
+
+    if (mBitmaps.size() + mPaths.size() >= mPurgeAt)
+    {
+        Purge();
+        mPurgeAt = std::max((mBitmaps.size() + mPaths.size()) * 2, size_t(MinPurge));
+    }
+
+    auto& resource = resources[key];
+    resource.mOwner = owner;
+    resource.mResource = create();
+    return resource.mResource;
+}
+
+/**
+ * Get a bitmap of an image
+ * @param graphics Graphics context the bitmap will be drawn on
+ * @param image The image, which must not change
+ * @return Graphics bitmap
+ */
+wxGraphicsBitmap GraphicsResourceCache::GetBitmap(std::shared_ptr<wxGraphicsContext> graphics,
+        const std::shared_ptr<const wxImage>& image)
+{
+    return GetBitmap(graphics, image, 0, [&graphics, &image]() {
+        FrameProfiler::Scope profile(FrameProfiler::Phase::CreateBitmap);
+        return graphics->CreateBitmapFromImage(*image);
+    });
+}
+
+/**
+ * Get a bitmap made from an object
+ * @param graphics Graphics context the bitmap will be drawn on
+ * @param owner Object the bitmap is made from
+ * @param variant Which of the bitmaps made from the object.
+ * Variant 0 of an image is the image itself.
+ * @param create Function that creates the bitmap if it is not in the cache
+ * @return Graphics bitmap
+ */
+wxGraphicsBitmap GraphicsResourceCache::GetBitmap(std::shared_ptr<wxGraphicsContext> graphics,
+        const std::shared_ptr<const void>& owner, int variant,
+        const std::function<wxGraphicsBitmap()>& create)
+{
+    return Find(mBitmaps, graphics, owner, variant, create);
+}
+
+/**
+ * Get a path made from an object
+ * @param graphics Graphics context the path will be drawn on
+ * @param owner Object the path is made from
+ * @param create Function that creates the path if it is not in the cache
+ * @return Graphics path
+ */
+wxGraphicsPath GraphicsResourceCache::GetPath(std::shared_ptr<wxGraphicsContext> graphics,
+        const std::shared_ptr<const void>& owner,
+        const std::function<wxGraphicsPath()>& create)
+{
+    return Find(mPaths, graphics, owner, 0, create);
+}
+
+/**
+ * Get a solid brush
+ * @param graphics Graphics context the brush will be used on
+ * @param colour Brush colour
+ * @return Graphics brush
+ */
+wxGraphicsBrush GraphicsResourceCache::GetBrush(std::shared_ptr<wxGraphicsContext> graphics, const wxColour& colour)
+{
+    auto key = std::make_pair(graphics->GetRenderer(), colour.GetRGBA());
+
+    auto found = mBrushes.find(key);
+    if (found != mBrushes.end())
+    {
+        mHits++;
+        return found->second;
+    }
+
+    mMisses++;
+    auto brush = graphics->CreateBrush(wxBrush(colour));
+    mBrushes[key] = brush;
+    return brush;
+}
+
+/**
+ * Release every resource made from an object
+ * @param owner The object
+ */
+void GraphicsResourceCache::Invalidate(const void* owner)
+{
+    for (auto iter = mBitmaps.begin(); iter != mBitmaps.end(); )
+    {
+        iter = iter->first.mOwner == owner ? mBitmaps.erase(iter) : std::next(iter);
+    }
+
+    for (auto iter = mPaths.begin(); iter != mPaths.end(); )
+    {
+        iter = iter->first.mOwner == owner ? mPaths.erase(iter) : std::next(iter);
+    }
+}
+
+/**
+ * Release one variant of the bitmaps made from an object
+ * @param owner The object
+ * @param variant Which of the bitmaps made from the object
+ */
+void GraphicsResourceCache::Invalidate(const void* owner, int variant)
+{
+    for (auto iter = mBitmaps.begin(); iter != mBitmaps.end(); )
+    {
+        bool match = iter->first.mOwner == owner && iter->first.mVariant == variant;
+        iter = match ? mBitmaps.erase(iter) : std::next(iter);
+    }
+}
+
+/**
+ * Release the resources of objects that no longer exist
+ */
+void GraphicsResourceCache::Purge()
+{
+    for (auto iter = mBitmaps.begin(); iter != mBitmaps.end(); )
+    {
+        iter = iter->second.mOwner.expired() ? mBitmaps.erase(iter) : std::next(iter);
+    }
+
+    for (auto iter = mPaths.begin(); iter != mPaths.end(); )
+    {
+        iter = iter->second.mOwner.expired() ? mPaths.erase(iter) : std::next(iter);
+    }
+}
+
+/**
+ * Release every resource and reset the counters
+ */
+void GraphicsResourceCache::Clear()
+{
+    mBitmaps.clear();
+    mPaths.clear();
+    mBrushes.clear();
+    mHits = 0;
+    mMisses = 0;
+    mPurgeAt = MinPurge;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file GraphicsResourceCache.h
+ * @author Aditya Menon
+ *
+ * Cache of the graphics bitmaps, paths and brushes things are drawn with
+ */
+
+#ifndef GRAPHICSRESOURCECACHE_H
+#define GRAPHICSRESOURCECACHE_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+
+/**
+ * Cache of the graphics bitmaps, paths and brushes things are drawn with.
+ *
+ * A new graphics context is created for every paint, but the
+ * resources it draws with only depend on its renderer, so they are
+ * kept here instead of in the things being drawn. Bitmaps and paths
+ * are keyed by the renderer, the object they are made from, such as
+ * an image, and a variant number that distinguishes different
+ * resources made from the same object. Brushes are keyed by the
+ * renderer and colour.
+ *
+ * The cache only holds weak pointers to the objects resources are
+ * made from, and their resources are released once those objects
+ * are gone. Invalidate releases them sooner.
+ *
+ * wxWidgets reference counts are not atomic, so graphics resources
+ * can not be shared between threads. Each thread has a cache of its
+ * own, which is the one Get returns, and nothing in it needs locking.
+ */
+class GraphicsResourceCache {
+private:
+    /// What a bitmap or path is made from
+    struct Key
+    {
+        /// Renderer the resource was created with
+        wxGraphicsRenderer* mRenderer;
+
+        /// Object the resource is made from
+        const void* mOwner;
+
+        /// Which of the resources made from the object
+        int mVariant;
+
+        /**
+         * Order keys so they can be used in a map
+         * @param other Key to compare to
+         * @return true if this key comes first
+         */
+        bool operator<(const Key& other) const
+        {
+            if (mRenderer != other.mRenderer) return mRenderer < other.mRenderer;
+            if (mOwner != other.mOwner) return mOwner < other.mOwner;
+            return mVariant < other.mVariant;
+        }
+    };
+
+    /// A cached bitmap or path
+    template<class T>
+    struct Resource
+    {
+        /// Object the resource is made from, to tell if it still exists
+        std::weak_ptr<const void> mOwner;
+
+        /// The resource
+        T mResource;
+    };
+
+    /// Cached bitmaps
+    std::map<Key, Resource<wxGraphicsBitmap>> mBitmaps;
+
+    /// Cached paths
+    std::map<Key, Resource<wxGraphicsPath>> mPaths;
+
+    /// Cached brushes by renderer and colour
+    std::map<std::pair<wxGraphicsRenderer*, wxUint32>, wxGraphicsBrush> mBrushes;
+
+    /// Number of requests satisfied from the cache
+    size_t mHits = 0;
+
+    /// Number of requests that had to create a resource
+    size_t mMisses = 0;
+
+    /// Number of bitmaps and paths at which to next release those of objects that are gone
+    size_t mPurgeAt = MinPurge;
+
+    /// Smallest number of bitmaps and paths that causes a purge
+    static const size_t MinPurge = 256;
+
+    GraphicsResourceCache() {}
+
+    template<class T>
+    T Find(std::map<Key, Resource<T>>& resources, std::shared_ptr<wxGraphicsContext> graphics,
+            const std::shared_ptr<const void>& owner, int variant, const std::function<T()>& create);
+
+public:
+    /// Copy constructor (disabled)
+    GraphicsResourceCache(const GraphicsResourceCache &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const GraphicsResourceCache &) = delete;
+
+    static GraphicsResourceCache& Get();
+
+    wxGraphicsBitmap GetBitmap(std::shared_ptr<wxGraphicsContext> graphics,
+            const std::shared_ptr<const wxImage>& image);
+
+    wxGraphicsBitmap GetBitmap(std::shared_ptr<wxGraphicsContext> graphics,
+            const std::shared_ptr<const void>& owner, int variant,
+            const std::function<wxGraphicsBitmap()>& create);
+
+    wxGraphicsPath GetPath(std::shared_ptr<wxGraphicsContext> graphics,
+            const std::shared_ptr<const void>& owner,
+            const std::function<wxGraphicsPath()>& create);
+
+    wxGraphicsBrush GetBrush(std::shared_ptr<wxGraphicsContext> graphics, const wxColour& colour);
+
+    void Invalidate(const void* owner);
+    void Invalidate(const void* owner, int variant);
+    void Purge();
+    void Clear();
+
+    /**
+     * Get the number of requests satisfied from the cache
+     * @return Number of hits
+     */
+    size_t GetHits() const { return mHits; }
+
+    /**
+     * Get the number of requests that had to create a resource
+     * @return Number of misses
+     */
+    size_t GetMisses() const { return mMisses; }
+
+    /**
+     * Get the number of cached resources
+     * @return Number of bitmaps, paths and brushes
+     */
+    size_t GetCount() const { return mBitmaps.size() + mPaths.size() + mBrushes.size(); }
+};
+
+#endif //GRAPHICSRESOURCECACHE_H
@@ -0,0 +1,143 @@
+/**
+ * @file ImageAtlas.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cstring>
+#include "ImageAtlas.h"
+
+/**
+ * Pack images into pages, replacing anything already in the atlas.
+ *
+ * Images are placed tallest first on shelves that run across the
+ * page. Images too large to fit on a page are left out, and Find
+ * will not find them.
+ *
+ * @param images Name and image of each image to pack
+ */
+void ImageAtlas::Build(const std::vector<std::pair<std::wstring, std::shared_ptr<const wxImage>>>& images)
+{
+    mPages.clear();
+    mRegions.clear();
+
+    std::vector<size_t> order;
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        auto& image = images[i].second;
+        if (image->GetWidth() + Padding * 2 <= PageSize && image->GetHeight() + Padding * 2 <= PageSize)
+        {
+            order.push_back(i);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+        return images[a].second->GetHeight() > images[b].second->GetHeight();
+    });
+
+    //
+    // Decide where everything goes
+    //
+    std::vector<int> heights;
+    int x = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    for (auto i : order)
+    {
+        auto& image = images[i].second;
+        int width = image->GetWidth() + Padding * 2;
+        int height = image->GetHeight() + Padding * 2;
+
+        if (x + width > PageSize)
+        {
+            // Start a new shelf
+            x = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        if (heights.empty() || shelfY + height > PageSize)
+        {
+            // Start a new page
+            heights.push_back(0);
+            x = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        Region region;
+        region.mPage = (int)heights.size() - 1;
+        region.mRect = wxRect(x + Padding, shelfY + Padding, image->GetWidth(), image->GetHeight());
+        mRegions[images[i].first] = region;
+
+        x += width;
+        shelfHeight = std::max(shelfHeight, height);
+        heights.back() = std::max(heights.back(), shelfY + shelfHeight);
+    }
+
+    //
+    // Create the pages, fully transparent to start
+    //
+    std::vector<wxImage> pages;
+    for (auto height : heights)
+    {
+        wxImage page(PageSize, height);
+        page.InitAlpha();
+        memset(page.GetAlpha(), 0, size_t(PageSize) * height);
+        pages.push_back(page);
+    }
+
+    //
+    // Copy each image and its padding into place
+    //
+    for (auto i : order)
+    {
+        auto& region = mRegions[images[i].first];
+        auto& page = pages[region.mPage];
+
+        // Masks become alpha, and images without either are opaque
+        wxImage source = images[i].second->Copy();
+        if (!source.HasAlpha())
+        {
+            source.InitAlpha();
+        }
+
+        int width = source.GetWidth();
+        int height = source.GetHeight();
+        auto sourceData = source.GetData();
+        auto sourceAlpha = source.GetAlpha();
+        auto pageData = page.GetData();
+        auto pageAlpha = page.GetAlpha();
+
+        for (int y = -Padding; y < height + Padding; y++)
+        {
+            int sy = std::min(std::max(y, 0), height - 1);
+            for (int x = -Padding; x < width + Padding; x++)
+            {
+                int sx = std::min(std::max(x, 0), width - 1);
+                size_t from = size_t(sy) * width + sx;
+                size_t to = size_t(region.mRect.y + y) * PageSize + region.mRect.x + x;
+
+                memcpy(pageData + to * 3, sourceData + from * 3, 3);
+                pageAlpha[to] = sourceAlpha[from];
+            }
+        }
+    }
+
+    for (auto& page : pages)
+    {
+        mPages.push_back(std::make_shared<const wxImage>(page));
+    }
+}
+
+/**
+ * Find where an image is in the atlas
+ * @param name Name the image was added with
+ * @return Region or nullptr if the image is not in the atlas
+ */
+const ImageAtlas::Region* ImageAtlas::Find(const std::wstring& name) const
+{
+    auto found = mRegions.find(name);
+    return found != mRegions.end() ? &found->second : nullptr;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file ImageAtlas.h
+ * @author Aditya Menon
+ *
+ * Images packed together into a few large pages
+ */
+
+#ifndef IMAGEATLAS_H
+#define IMAGEATLAS_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Images packed together into a few large pages.
+ *
+ * Drawing an image from an atlas means drawing the part of its page
+ * where the image is, so every image on a page shares the graphics
+ * bitmap of the page instead of needing one of its own.
+ *
+ * Each image is surrounded by Padding pixels that repeat its edge
+ * pixels, so filtering when an image is scaled does not pick up
+ * its neighbours on the page.
+ *
+ * Once built, an atlas does not change and may be used from any
+ * thread. ImageCache owns the atlases.
+ */
+class ImageAtlas {
+public:
+    /// Width and maximum height of a page in pixels
+    static const int PageSize = 1024;
+
+    /// Pixels around each image that repeat its edge
+    static const int Padding = 2;
+
+    /// Where an image is in the atlas
+    struct Region
+    {
+        /// Page the image is on
+        int mPage = 0;
+
+        /// Rectangle the image occupies on the page, without the padding
+        wxRect mRect;
+    };
+
+private:
+    /// The pages
+    std::vector<std::shared_ptr<const wxImage>> mPages;
+
+    /// Where each image is, by the name it was added with
+    std::map<std::wstring, Region> mRegions;
+
+public:
+    ImageAtlas() {}
+
+    /// Copy constructor (disabled)
+    ImageAtlas(const ImageAtlas &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const ImageAtlas &) = delete;
+
+    void Build(const std::vector<std::pair<std::wstring, std::shared_ptr<const wxImage>>>& images);
+
+    const Region* Find(const std::wstring& name) const;
+
+    /**
+     * Get the number of pages
+     * @return Number of pages
+     */
+    int GetNumPages() const { return (int)mPages.size(); }
+
+    /**
+     * Get a page
+     * @param page Page index
+     * @return Page image
+     */
+    const std::shared_ptr<const wxImage>& GetPage(int page) const { return mPages[page]; }
+};
+
+#endif //IMAGEATLAS_H
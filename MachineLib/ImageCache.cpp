@@ -0,0 +1,241 @@
+/**
+ * @file ImageCache.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "ImageCache.h"
+
+/**
+ * Constructor, private so the only instance is the one from Get
+ */
+ImageCache::ImageCache() : mBudget(DefaultBudget)
+{
+}
+
+/**
+ * Get the process-wide image cache
+ * @return The image cache
+ */
+ImageCache& ImageCache::Get()
+{
+    static ImageCache cache;
+    return cache;
+}
+
+/**
+ * Convert a filename to the key the cache uses for it
+ * @param filename Image filename, relative or absolute
+ * @return Absolute path with any . and .. removed
+ */
+std::wstring ImageCache::CanonicalPath(const std::wstring& filename)
+{
+    wxFileName file(filename);
+    file.Normalize(wxPATH_NORM_DOTS | wxPATH_NORM_ABSOLUTE | wxPATH_NORM_LONG);
+    return file.GetFullPath().ToStdWstring();
+}
+
+/**
+ * Get a decoded image, loading it if it is not in the cache
+ * @param filename Image filename
+ * @return Shared image or nullptr if the file could not be loaded
+ */
+std::shared_ptr<const wxImage> ImageCache::GetImage(const std::wstring& filename)
+{
+    auto path = CanonicalPath(filename);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto found = mEntries.find(path);
+        if (found != mEntries.end())
+        {
+            mHits++;
+            Touch(found->second);
+            return found->second.mImage;
+        }
+    }
+
+    // Decode without holding the lock so other threads can use the
+    // cache in the meantime. Callers report failures themselves.
+    wxLogNull logNo;
+    auto image = std::make_shared<wxImage>();
+    if (!image->LoadFile(path, wxBITMAP_TYPE_ANY))
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMisses++;
+
+    // Another thread may have loaded the same file while we were
+    auto found = mEntries.find(path);
+    if (found != mEntries.end())
+    {
+        Touch(found->second);
+        return found->second.mImage;
+    }
+
+    size_t bytes = size_t(image->GetWidth()) * image->GetHeight() * (image->HasAlpha() ? 4 : 3);
+
+    Entry& entry = mEntries[path];
+    entry.mImage = image;
+    entry.mBytes = bytes;
+    mRecent.push_front(path);
+    entry.mRecent = mRecent.begin();
+    mPaths[image.get()] = path;
+    mBytes += bytes;
+
+    Trim();
+
+    return image;
+}
+
+/**
+ * Pack images in a directory into an atlas, unless that
+ * directory already has one
+ *
+ * Only the named images are packed, so other images that share
+ * the directory do not make the pages larger. Names that can not
+ * be loaded are skipped. The images are also added to the cache
+ * as usual.
+ *
+ * @param directory Directory containing the images
+ * @param names Filenames of the images within the directory
+ */
+void ImageCache::LoadAtlas(const std::wstring& directory, const std::vector<std::wstring>& names)
+{
+    auto path = CanonicalPath(directory);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mAtlases.find(path) != mAtlases.end())
+        {
+            return;
+        }
+    }
+
+    std::vector<std::pair<std::wstring, std::shared_ptr<const wxImage>>> images;
+    for (auto& name : names)
+    {
+        auto file = path + L"/" + name;
+        auto image = GetImage(file);
+        if (image != nullptr)
+        {
+            images.emplace_back(CanonicalPath(file), image);
+        }
+    }
+
+    auto atlas = std::make_unique<ImageAtlas>();
+    atlas->Build(images);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Another thread may have loaded the same directory while we were
+    if (mAtlases.find(path) != mAtlases.end())
+    {
+        return;
+    }
+
+    for (auto& image : images)
+    {
+        if (atlas->Find(image.first) != nullptr)
+        {
+            mAtlasImages[image.first] = atlas.get();
+        }
+    }
+
+    mAtlases[path] = std::move(atlas);
+}
+
+/**
+ * Find the atlas page an image is on
+ * @param image Image obtained from GetImage
+ * @param page Set to the page image
+ * @param rect Set to the rectangle the image occupies on the page
+ * @return true if the image is in an atlas
+ */
+bool ImageCache::FindInAtlas(const std::shared_ptr<const wxImage>& image,
+        std::shared_ptr<const wxImage>& page, wxRect& rect)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto path = mPaths.find(image.get());
+    if (path == mPaths.end())
+    {
+        return false;
+    }
+
+    auto atlas = mAtlasImages.find(path->second);
+    if (atlas == mAtlasImages.end())
+    {
+        return false;
+    }
+
+    auto region = atlas->second->Find(path->second);
+    page = atlas->second->GetPage(region->mPage);
+    rect = region->mRect;
+    return true;
+}
+
+/**
+ * Set the memory budget, releasing unused images if over it
+ * @param bytes Budget in bytes
+ */
+void ImageCache::SetBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mBudget = bytes;
+    Trim();
+}
+
+/**
+ * Remove every image and atlas from the cache. Images still in
+ * use stay valid for their holders but are no longer shared.
+ * The hit and miss counts start again from zero.
+ */
+void ImageCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAtlasImages.clear();
+    mAtlases.clear();
+    mEntries.clear();
+    mPaths.clear();
+    mRecent.clear();
+    mBytes = 0;
+    mHits = 0;
+    mMisses = 0;
+}
+
+/**
+ * Mark an entry as the most recently used
+ * @param entry Entry that was used
+ */
+void ImageCache::Touch(Entry& entry)
+{
+    mRecent.splice(mRecent.begin(), mRecent, entry.mRecent);
+}
+
+/**
+ * Release unused images until the cache fits in the budget.
+ * The mutex must be held.
+ */
+void ImageCache::Trim()
+{
+    // Walk from the least recently used end
+    auto iter = mRecent.end();
+    while (mBytes > mBudget && iter != mRecent.begin())
+    {
+        --iter;
+
+        auto found = mEntries.find(*iter);
+        auto& entry = found->second;
+
+        // Only the cache holds this image, so nothing is lost by freeing it
+        if (entry.mImage.use_count() == 1)
+        {
+            mBytes -= entry.mBytes;
+            mPaths.erase(entry.mImage.get());
+            mEntries.erase(found);
+            iter = mRecent.erase(iter);
+        }
+    }
+}
@@ -0,0 +1,197 @@
+/**
+ * @file ImageCache.h
+ * @author Aditya Menon
+ *
+ * Process-wide cache of decoded images
+ */
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <memory>
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+#include <mutex>
+#include "ImageAtlas.h"
+
+/**
+ * Process-wide cache of decoded images.
+ *
+ * Every image file is decoded once and shared by everything that
+ * displays it. Images are keyed by their canonical path, so
+ * different spellings of the same file share one entry. The images
+ * handed out are immutable; anything that needs to change the
+ * pixels must make its own copy.
+ *
+ * Graphics bitmaps of the images are kept by the
+ * GraphicsResourceCache.
+ *
+ * LoadAtlas packs a list of images in a directory into an ImageAtlas.
+ * Images in an atlas are drawn from their atlas page, found with
+ * FindInAtlas, so they share the bitmap of the page. Atlases are
+ * not counted against the budget.
+ *
+ * When the decoded images use more memory than the budget, the
+ * least recently used images that nobody holds any longer are
+ * released. Images that are still in use are never released, so
+ * the budget can be exceeded while they are held.
+ *
+ * All functions may be called from any thread.
+ */
+class ImageCache {
+private:
+    /// A cached image
+    struct Entry
+    {
+        /// The decoded image
+        std::shared_ptr<const wxImage> mImage;
+
+        /// Memory used by the decoded pixels in bytes
+        size_t mBytes = 0;
+
+        /// Position in mRecent
+        std::list<std::wstring>::iterator mRecent;
+    };
+
+    /// Cached images by canonical path
+    std::map<std::wstring, Entry> mEntries;
+
+    /// Canonical path of each cached image
+    std::map<const wxImage*, std::wstring> mPaths;
+
+    /// Atlases by the canonical path of the directory they were loaded from
+    std::map<std::wstring, std::unique_ptr<ImageAtlas>> mAtlases;
+
+    /// The atlas each image is in, by canonical path
+    std::map<std::wstring, ImageAtlas*> mAtlasImages;
+
+    /// Canonical paths, most recently used first
+    std::list<std::wstring> mRecent;
+
+    /// Memory used by all decoded images in bytes
+    size_t mBytes = 0;
+
+    /// Memory budget in bytes
+    size_t mBudget;
+
+    /// Number of image requests satisfied from the cache
+    size_t mHits = 0;
+
+    /// Number of image requests that had to decode a file
+    size_t mMisses = 0;
+
+    /// Protects everything above
+    mutable std::mutex mMutex;
+
+    /**
+     * Constructor, private so the only instance is the one from Get
+     */
+    ImageCache();
+
+    /**
+     * Mark an entry as the most recently used
+     * @param entry Entry that was used
+     */
+    void Touch(Entry& entry);
+
+    /**
+     * Release unused images until the cache fits in the budget.
+     * The mutex must be held.
+     */
+    void Trim();
+
+public:
+    /// Default memory budget in bytes
+    static const size_t DefaultBudget = 256 * 1024 * 1024;
+
+    /// Copy constructor (disabled)
+    ImageCache(const ImageCache &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const ImageCache &) = delete;
+
+    /**
+     * Get the process-wide image cache
+     * @return The image cache
+     */
+    static ImageCache& Get();
+
+    /**
+     * Convert a filename to the key the cache uses for it
+     * @param filename Image filename, relative or absolute
+     * @return Absolute path with any . and .. removed
+     */
+    static std::wstring CanonicalPath(const std::wstring& filename);
+
+    /**
+     * Get a decoded image, loading it if it is not in the cache
+     * @param filename Image filename
+     * @return Shared image or nullptr if the file could not be loaded
+     */
+    std::shared_ptr<const wxImage> GetImage(const std::wstring& filename);
+
+    /**
+     * Pack images in a directory into an atlas, unless that
+     * directory already has one
+     * @param directory Directory containing the images
+     * @param names Filenames of the images within the directory
+     */
+    void LoadAtlas(const std::wstring& directory, const std::vector<std::wstring>& names);
+
+    /**
+     * Find the atlas page an image is on
+     * @param image Image obtained from GetImage
+     * @param page Set to the page image
+     * @param rect Set to the rectangle the image occupies on the page
+     * @return true if the image is in an atlas
+     */
+    bool FindInAtlas(const std::shared_ptr<const wxImage>& image,
+            std::shared_ptr<const wxImage>& page, wxRect& rect);
+
+    /**
+     * Set the memory budget, releasing unused images if over it
+     * @param bytes Budget in bytes
+     */
+    void SetBudget(size_t bytes);
+
+    /**
+     * Remove every image and atlas from the cache. Images still in
+     * use stay valid for their holders but are no longer shared.
+     * The hit and miss counts start again from zero.
+     */
+    void Clear();
+
+    /**
+     * Get the memory budget
+     * @return Budget in bytes
+     */
+    size_t GetBudget() const { std::lock_guard<std::mutex> lock(mMutex); return mBudget; }
+
+    /**
+     * Get the memory used by decoded images
+     * @return Memory in bytes
+     */
+    size_t GetBytes() const { std::lock_guard<std::mutex> lock(mMutex); return mBytes; }
+
+    /**
+     * Get the number of cached images
+     * @return Number of images
+     */
+    size_t GetCount() const { std::lock_guard<std::mutex> lock(mMutex); return mEntries.size(); }
+
+    /**
+     * Get the number of image requests satisfied from the cache
+     * @return Number of hits
+     */
+    size_t GetHits() const { std::lock_guard<std::mutex> lock(mMutex); return mHits; }
+
+    /**
+     * Get the number of image requests that had to decode a file
+     * @return Number of misses
+     */
+    size_t GetMisses() const { std::lock_guard<std::mutex> lock(mMutex); return mMisses; }
+};
+
+#endif //IMAGECACHE_H
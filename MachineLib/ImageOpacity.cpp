@@ -0,0 +1,49 @@
+/**
+ * @file ImageOpacity.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "ImageOpacity.h"
+
+/**
+ * Create a copy of an image faded to an opacity level
+ * @param image Image to copy
+ * @param level Opacity level from 0 to Levels
+ * @return Copy of the image with an alpha channel scaled to the level
+ */
+wxImage ImageOpacity::Create(const wxImage& image, int level)
+{
+    wxImage faded = image.Copy();
+
+    // Masks become alpha, and images without either are opaque
+    if (!faded.HasAlpha())
+    {
+        faded.InitAlpha();
+    }
+
+    ScaleAlpha(faded.GetAlpha(), size_t(faded.GetWidth()) * faded.GetHeight(),
+            (level * 255 + Levels / 2) / Levels);
+    return faded;
+}
+
+/**
+ * Scale alpha values, rounding to the nearest value.
+ *
+ * The loop has no branches and only uses 16 bit arithmetic,
+ * so the compiler vectorizes it.
+ *
+ * @param alpha Alpha values to scale in place
+ * @param count Number of values
+ * @param scale Scale from 0 to 255, where 255 leaves the values unchanged
+ */
+void ImageOpacity::ScaleAlpha(unsigned char* alpha, size_t count, int scale)
+{
+    auto s = (unsigned short)scale;
+    for (size_t i = 0; i < count; i++)
+    {
+        // Exact rounded division by 255 of a product of two bytes
+        unsigned short v = (unsigned short)(alpha[i] * s + 128);
+        alpha[i] = (unsigned char)((v + (v >> 8)) >> 8);
+    }
+}
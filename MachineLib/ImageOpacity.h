@@ -0,0 +1,39 @@
+/**
+ * @file ImageOpacity.h
+ * @author Aditya Menon
+ *
+ * Faded copies of images at a small set of opacity levels
+ */
+
+#ifndef IMAGEOPACITY_H
+#define IMAGEOPACITY_H
+
+/**
+ * Faded copies of images at a small set of opacity levels.
+ *
+ * Drawing an image partly transparent either needs a transparency
+ * layer, which composites through an offscreen buffer on every draw,
+ * or a copy of the image with its alpha scaled. Opacities are rounded
+ * to one of Levels steps, so a fading image only ever needs a few
+ * copies, and the copies can be kept in the GraphicsResourceCache as
+ * variants of the image for as long as the image exists.
+ */
+class ImageOpacity {
+public:
+    /// Number of steps from transparent to opaque
+    static const int Levels = 32;
+
+    ImageOpacity() = delete;
+
+    /**
+     * Round an opacity to the nearest level
+     * @param opacity Opacity from 0 to 1
+     * @return Level from 0 (transparent) to Levels (opaque)
+     */
+    static int Quantize(double opacity) { return int(opacity * Levels + 0.5); }
+
+    static wxImage Create(const wxImage& image, int level);
+    static void ScaleAlpha(unsigned char* alpha, size_t count, int scale);
+};
+
+#endif //IMAGEOPACITY_H
@@ -6,6 +6,11 @@
 #include "pch.h"
 #include "Machine.h"
 #include "Component.h"
+#include "DriveGraph.h"
+#include "Polygon.h"
+#include "GraphicsResourceCache.h"
+#include <cmath>
+#include <cstring>
 
 /**
  * Constructor
@@ -29,14 +34,124 @@ Machine::Machine(int machineNum) : mMachineNum(machineNum)
  */
 void Machine::Draw(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position)
 {
-    // Draw all components
-    for(auto component : mComponents)
+    // The static components at the start of the list are under
+    // everything else, so they can come from the static layer
+    size_t numStatic = 0;
+    while (numStatic < mComponents.size() && mComponents[numStatic] != nullptr &&
+            mComponents[numStatic]->IsStatic())
+    {
+        numStatic++;
+    }
+
+    if (numStatic > 1)
     {
-        if (component != nullptr)
+        DrawStaticLayer(graphics, position, numStatic);
+    }
+    else
+    {
+        // One component is already one cached bitmap or path,
+        // so a layer would only add another blit
+        numStatic = 0;
+    }
+
+    // Draw the rest of the components
+    for (size_t i = numStatic; i < mComponents.size(); i++)
+    {
+        if (mComponents[i] != nullptr)
+        {
+            mComponents[i]->Draw(graphics, position);
+        }
+    }
+}
+
+/**
+ * Draw the static components from the static layer.
+ *
+ * The layer is an image of the static components drawn at the
+ * device scale, so it is drawn one image pixel to one device pixel.
+ * It covers only the area the static components fill, and is drawn
+ * again when the scale changes or the layer is invalidated.
+ *
+ * @param graphics Graphics context to draw on
+ * @param position Position to draw at
+ * @param numStatic Number of static components at the start of the list
+ */
+void Machine::DrawStaticLayer(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position, size_t numStatic)
+{
+    double a, b, c, d, tx, ty;
+    graphics->GetTransform().Get(&a, &b, &c, &d, &tx, &ty);
+    double scale = sqrt(a * a + b * b);
+
+    if (mStaticLayer == nullptr || scale != mStaticLayerScale)
+    {
+        // The area the static components cover. A component with a
+        // rotation can turn about its position, so it gets the circle
+        // its bounding box sweeps.
+        wxRect2DDouble bounds;
+        bool first = true;
+        for (size_t i = 0; i < numStatic; i++)
+        {
+            auto& component = mComponents[i];
+            auto base = component->GetBase();
+            if (base == nullptr || std::distance(base->begin(), base->end()) < 3)
+            {
+                continue;
+            }
+
+            auto box = base->BoundingBox();
+            if (component->GetCurrentRotation() != 0 || component->GetPhase() != 0)
+            {
+                double x = std::max(fabs(box.m_x), fabs(box.GetRight()));
+                double y = std::max(fabs(box.m_y), fabs(box.GetBottom()));
+                double radius = sqrt(x * x + y * y);
+                box = wxRect2DDouble(-radius, -radius, radius * 2, radius * 2);
+            }
+
+            box.Offset(wxPoint2DDouble(component->GetPosition().x, component->GetPosition().y));
+            if (first)
+            {
+                bounds = box;
+                first = false;
+            }
+            else
+            {
+                bounds.Union(box);
+            }
+        }
+
+        // A pixel of margin for the antialiased edges
+        int left = int(floor(bounds.m_x)) - 1;
+        int top = int(floor(bounds.m_y)) - 1;
+        int right = int(ceil(bounds.GetRight())) + 1;
+        int bottom = int(ceil(bounds.GetBottom())) + 1;
+        mStaticLayerBounds = wxRect(left, top, right - left, bottom - top);
+
+        int width = std::max(1, int(mStaticLayerBounds.width * scale + 0.5));
+        int height = std::max(1, int(mStaticLayerBounds.height * scale + 0.5));
+
+        // Fully transparent to start
+        wxImage layer(width, height);
+        layer.InitAlpha();
+        memset(layer.GetAlpha(), 0, size_t(width) * height);
+
         {
-            component->Draw(graphics, position);
+            // The context must be gone before the image is complete
+            auto layerGraphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(layer));
+            layerGraphics->Scale(scale, scale);
+            for (size_t i = 0; i < numStatic; i++)
+            {
+                mComponents[i]->Draw(layerGraphics, wxPoint(-left, -top));
+            }
         }
+
+        mStaticLayer = std::make_shared<const wxImage>(layer);
+        mStaticLayerScale = scale;
+        mStaticLayerDraws++;
     }
+
+    graphics->DrawBitmap(GraphicsResourceCache::Get().GetBitmap(graphics, mStaticLayer),
+            position.x + mStaticLayerBounds.x, position.y + mStaticLayerBounds.y,
+            mStaticLayerBounds.width, mStaticLayerBounds.height);
 }
 
 /**
@@ -47,6 +162,10 @@ void Machine::AddComponent(std::shared_ptr<Component> component)
 {
     mComponents.push_back(component);
     component->SetMachine(this);
+    InvalidateStaticLayer();
+    
+    // The drive graph no longer matches the components
+    mDriveGraph = nullptr;
 }
 
 /**
@@ -111,3 +230,67 @@ int Machine::GetMachineNum()
 {
     return mMachineNum;
 }
+
+/**
+ * Compile the rotation connections between components into a drive graph
+ *
+ * This should be called once the machine has been built. A cycle in the
+ * connections is reported here rather than showing up as components
+ * that never settle on a rotation.
+ *
+ * @return true if the connections are free of cycles
+ */
+bool Machine::Compile()
+{
+    mDriveGraph = std::make_shared<DriveGraph>();
+    if (!mDriveGraph->Compile(mComponents))
+    {
+        wxLogWarning(L"Machine %d: %d components are connected in a drive cycle",
+                mMachineNum, (int)mDriveGraph->GetCycleCount());
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * Set the time for all components of the machine
+ * @param time Time in seconds
+ */
+void Machine::SetTime(double time)
+{
+    if (mDriveGraph == nullptr)
+    {
+        Compile();
+    }
+    
+    mDriveGraph->Evaluate(time);
+}
+
+/**
+ * Compute the rotation of every component at a time without changing the machine
+ *
+ * This only reads the compiled drive graph, so several threads
+ * can evaluate the same machine at once.
+ *
+ * @param time Time in seconds
+ * @param rotations Filled with the rotation in radians of each component,
+ * in the same order as GetComponents
+ */
+void Machine::EvaluateRotations(double time, std::vector<double>& rotations) const
+{
+    if (mDriveGraph == nullptr)
+    {
+        // Not compiled, so nothing is driven
+        rotations.clear();
+        for (auto& component : mComponents)
+        {
+            rotations.push_back(component->GetCurrentRotation());
+        }
+        return;
+    }
+    
+    // The graph lists the machine components first, in order
+    mDriveGraph->EvaluateRotations(time, rotations);
+    rotations.resize(mComponents.size());
+}
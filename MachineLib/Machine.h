@@ -14,9 +14,14 @@
 // Forward references
 class Component;
 class MachineSystem;
+class DriveGraph;
 
 /**
  * Class for a machine
+ *
+ * The static components at the start of the component list never
+ * change, so they are drawn once into a cached layer and that
+ * layer is drawn under the rest of the components each frame.
  */
 class Machine {
 private:
@@ -31,6 +36,30 @@ private:
     
     /// The motor component
     std::shared_ptr<Component> mMotor;
+    
+    /// The compiled rotation connections between components
+    std::shared_ptr<DriveGraph> mDriveGraph;
+    
+    /// The static components at the start of the component list, drawn
+    /// once at mStaticLayerScale, or nullptr if not drawn yet
+    std::shared_ptr<const wxImage> mStaticLayer;
+    
+    /// The area mStaticLayer covers, relative to the machine position
+    wxRect mStaticLayerBounds;
+    
+    /// The device scale mStaticLayer was drawn at
+    double mStaticLayerScale = 0;
+    
+    /// Number of times the static layer has been drawn
+    int mStaticLayerDraws = 0;
+    
+    /**
+     * Draw the static components from the static layer
+     * @param graphics Graphics context to draw on
+     * @param position Position to draw at
+     * @param numStatic Number of static components at the start of the list
+     */
+    void DrawStaticLayer(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position, size_t numStatic);
 
 public:
     Machine();
@@ -91,11 +120,44 @@ public:
      */
     int GetMachineNum();
     
+    /**
+     * Compile the rotation connections between components into a drive graph
+     * @return true if the connections are free of cycles
+     */
+    bool Compile();
+    
+    /**
+     * Set the time for all components of the machine
+     * @param time Time in seconds
+     */
+    void SetTime(double time);
+    
+    /**
+     * Compute the rotation of every component at a time without changing the machine
+     * @param time Time in seconds
+     * @param rotations Filled with the rotation in radians of each component,
+     * in the same order as GetComponents
+     */
+    void EvaluateRotations(double time, std::vector<double>& rotations) const;
+    
     /**
      * Get the components in this machine
      * @return Vector of components
      */
     std::vector<std::shared_ptr<Component>>& GetComponents() { return mComponents; }
+    
+    /**
+     * Indicate the static components have changed, so the static
+     * layer must be drawn again. Components do this themselves
+     * when they are changed through their own setters.
+     */
+    void InvalidateStaticLayer() { mStaticLayer = nullptr; }
+    
+    /**
+     * Get the number of times the static layer has been drawn
+     * @return Number of static layer draws
+     */
+    int GetStaticLayerDraws() const { return mStaticLayerDraws; }
 };
 
 #endif //MACHINE_H
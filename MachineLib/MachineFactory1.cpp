@@ -10,7 +10,6 @@
 #include "Pulley.h"
 #include "Shape.h"
 #include "BubbleBlower.h"
-#include "Bubble.h"
 
 using namespace std;
 
@@ -362,6 +361,8 @@ std::shared_ptr<Machine> MachineFactory1::Create()
     bubbleBlower->SetCurrentRotation(-0.3);  // More tilt to the left
     // Set image directory for the bubble blower to find bubble.png
     bubbleBlower->SetImageDirectory(mImagesDir);
+    // Fixed seed so the same frame always shows the same bubbles
+    bubbleBlower->SetSeed(1);
 
     //
     // Set up ROTATION RELATIONSHIPS - BEFORE adding components to machine
@@ -416,6 +417,14 @@ std::shared_ptr<Machine> MachineFactory1::Create()
     machine->AddComponent(beltExtension1);
     machine->AddComponent(beltExtension2);
     
+    // Nothing drives the parts added so far, and the motor draws
+    // unrotated, so they are static. The machine draws them from
+    // a cached layer under the moving parts.
+    for (auto& component : machine->GetComponents())
+    {
+        component->SetStatic(true);
+    }
+    
     // Add all pulleys (these will be drawn on top of the belts)
     machine->AddComponent(pulley1);
     machine->AddComponent(pulley3);
@@ -429,6 +438,9 @@ std::shared_ptr<Machine> MachineFactory1::Create()
     // Add the bubble blower (after the flag so bubbles appear on top)
     machine->AddComponent(bubbleBlower);
     
+    // Compile the rotation relationships now that the machine is complete
+    machine->Compile();
+    
     return machine;
 }
 
@@ -11,10 +11,21 @@
 #include "MachineFactory1.h"
 #include "MachineFactory2.h"
 #include "Component.h"
+#include "FrameProfiler.h"
+#include "ImageCache.h"
 
 /// The images directory
 const std::wstring ImagesDirectory = L"/images";
 
+/// The machine part images, which are packed into an atlas.
+/// Other images may share the images directory when the
+/// resources are copied next to an application's own.
+const std::vector<std::wstring> AtlasImages = {
+    L"base.png", L"post.png", L"platform.png",
+    L"pulley1.png", L"pulley2.png", L"pulley3.png", L"pulley4.png",
+    L"motor3.png", L"blower.png", L"flag.png", L"bubble.png"
+};
+
 /**
  * Constructor
  * @param resourcesDir Directory for resources
@@ -41,6 +52,9 @@ MachineSystem::MachineSystem(const std::wstring& resourcesDir)
     mTime = 0;
     mPosition = wxPoint(400, 400);  // Set machine at center of window
     
+    // Pack the machine images into an atlas before any are drawn
+    ImageCache::Get().LoadAtlas(mResourcesDir + ImagesDirectory, AtlasImages);
+
     // Create machine factories
     mFactory1 = MachineFactory1::Create(mResourcesDir);
     mFactory2 = MachineFactory2::Create(mResourcesDir);
@@ -207,31 +221,39 @@ void MachineSystem::SetFlag(int flag)
  */
 void MachineSystem::SetTime(double time)
 {
+    FrameProfiler::Scope profile(FrameProfiler::Phase::MachineTime);
+
     mTime = time;
     
     if (mMachine != nullptr)
     {
-        // Get the components from the machine
-        auto& components = mMachine->GetComponents();
-        
-        // First pass: update all components for time
-        for(auto component : components)
-        {
-            component->SetTime(time);
-        }
-        
-        // Second pass: ensure rotation propagation
-        for(auto component : components)
-        {
-            component->SetTime(time);
-        }
-        
-        // Third pass to fully synchronize
-        for(auto component : components)
-        {
-            component->SetTime(time);
-        }
+        // Rotations are computed directly from the
+        // rates in the machine's drive graph
+        mMachine->SetTime(time);
+    }
+}
+
+/**
+ * Compute the rotation of every machine component at a time
+ * without changing the machine
+ *
+ * This is the stateless form of SetTime. Every rotation comes
+ * from a per-component rate cached when the machine was built,
+ * so the cost is the same for any time and it is safe to call
+ * from several threads at once.
+ *
+ * @param time Time in seconds since the machine started
+ * @param rotations Filled with the rotation in radians of each component
+ */
+void MachineSystem::EvaluateRotations(double time, std::vector<double>& rotations) const
+{
+    if (mMachine == nullptr)
+    {
+        rotations.clear();
+        return;
     }
+    
+    mMachine->EvaluateRotations(time, rotations);
 }
 
 /**
@@ -11,6 +11,7 @@
 #include "IMachineSystem.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 // Forward references
 class Machine;
@@ -131,6 +132,14 @@ public:
      */
     void SetTime(double time);
     
+    /**
+     * Compute the rotation of every machine component at a time
+     * without changing the machine
+     * @param time Time in seconds since the machine started
+     * @param rotations Filled with the rotation in radians of each component
+     */
+    void EvaluateRotations(double time, std::vector<double>& rotations) const;
+    
     /**
      * Set the start time for this machine
      * @param startTime Time in seconds when the machine starts
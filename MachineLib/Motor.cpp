@@ -58,6 +58,19 @@ double Motor::GetSpeed()
     return mSpeed;
 }
 
+/**
+ * Get the rate the motor turns at
+ * @return Rotation rate in radians per second
+ */
+double Motor::GetRotationRate() const
+{
+    // For slower rotation, divide speed by a factor
+    double adjustedSpeed = mSpeed / 5.0;  // 5x slower rotation
+    
+    // Convert rotations per second to radians per second
+    return adjustedSpeed * 2 * M_PI;
+}
+
 /**
  * Draw the motor
  * @param graphics Graphics context to draw on
@@ -87,27 +100,13 @@ void Motor::SetTime(double time)
 {
     Component::SetTime(time);
     
-    // Compute rotation based on time and speed
-    // For slower rotation, divide speed by a factor
-    double adjustedSpeed = mSpeed / 5.0;  // 5x slower rotation
-    double rotation = time * adjustedSpeed;
-    
-    // Calculate rotation in radians
-    double rotationRadians = rotation * 2 * M_PI;
+    // Compute rotation in radians based on time and speed
+    double rotationRadians = time * GetRotationRate();
     
     // Store the rotation value but don't apply it to our base polygon
-    // This prevents the motor image from rotating
+    // This prevents the motor image from rotating. The machine's drive
+    // graph passes this rotation on to the components we drive.
     SetCurrentRotation(rotationRadians);
-    
-    // Only drive components that are explicitly connected to this motor
-    for (auto component : mDrivenComponents)
-    {
-        if (component != nullptr)
-        {
-            // Set the current rotation for the driven component
-            component->SetCurrentRotation(rotationRadians);
-        }
-    }
 }
 
 /**
@@ -51,6 +51,12 @@ public:
      */
     double GetSpeed();
     
+    /**
+     * Get the rate the motor turns at
+     * @return Rotation rate in radians per second
+     */
+    double GetRotationRate() const override;
+    
     void Draw(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position) override;
     
     void SetTime(double time) override;
@@ -73,6 +79,12 @@ public:
      * @return Pointer to the source
      */
     std::shared_ptr<Component> GetSource();
+    
+    /**
+     * Get the components driven by this motor
+     * @return Driven components
+     */
+    std::vector<Component*> GetDrivenComponents() override { return mDrivenComponents; }
 };
 
 #endif //MOTOR_H
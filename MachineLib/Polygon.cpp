@@ -11,6 +11,11 @@
 #include <wx/hyperlink.h>
 
 #include "Polygon.h"
+#include "PolygonGeometry.h"
+#include "GraphicsResourceCache.h"
+#include "ImageCache.h"
+#include "ImageOpacity.h"
+#include "FrameProfiler.h"
 
 using namespace cse335;
 
@@ -196,15 +201,18 @@ void Polygon::SetColor(wxColour color)
 
 /**
  * Set an image we will use as a texture for the polygon
+ *
+ * The decoded image is shared with every other polygon
+ * that uses the same file.
+ *
  * @param filename Image filename
  */
 void Polygon::SetImage(std::wstring filename)
 {
-    // Prevent error popup from wxWidgets
-    wxLogNull logNo;
-
-    mImage = std::make_unique<wxImage>();
-    if(mImage->LoadFile(filename, wxBITMAP_TYPE_ANY))
+    mImage = ImageCache::Get().GetImage(filename);
+    mAtlasPage = nullptr;
+    mAtlasChecked = false;
+    if(mImage != nullptr)
     {
         mMode = Mode::Image;
     }
@@ -227,7 +235,7 @@ void Polygon::SetImage(std::wstring filename)
  */
 void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y)
 {
-    if(mPoints.size() < 3)
+    if(GetPoints().size() < 3)
     {
         // Our polygon MUST have at least three points
         Assert(false,
@@ -236,15 +244,18 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
         return;
     }
 
+    FrameProfiler::Scope profile(FrameProfiler::Phase::DrawPolygon);
+
     mHasDrawn = true;
 
-#ifndef WIN32
-    if(mOpacity < 1)
+    if(mGeometry == nullptr)
     {
-        // Layer opacity does not work on Windows systems.
-        graphics->BeginLayer(mOpacity);
+        // No more points can be added, so the points
+        // can move to the shared geometry
+        mGeometry = PolygonGeometry::Create(std::move(mPoints), mIsCircle);
+        mPoints.clear();
+        mPoints.shrink_to_fit();
     }
-#endif
 
     switch (mMode) {
         case Mode::Color:
@@ -263,13 +274,6 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
                    L"https://facweb.cse.msu.edu/cbowen/cse335/polygon/c/");
             break;
     }
-
-#ifndef WIN32
-    if(mOpacity < 1)
-    {
-        graphics->EndLayer();
-    }
-#endif
 }
 
 
@@ -282,26 +286,25 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
  */
 void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y)
 {
-    if(mPath.IsNull())
-    {
-        // Create the graphics path
-        mPath = graphics->CreatePath();
-
-        mPath.MoveToPoint(mPoints[0].m_x, mPoints[0].m_y);
-        for(size_t i=1; i<mPoints.size(); i++)
-        {
-            mPath.AddLineToPoint(mPoints[i].m_x, mPoints[i].m_y);
-        }
-        mPath.CloseSubpath();
-    }
-
     graphics->PushState();
 
     graphics->Translate(x, y);
     graphics->Rotate((mRotation + mPhase) * M_PI * 2);
 
-    graphics->SetBrush(mBrush);
-    graphics->FillPath(mPath);
+    // A single filled path does not overlap itself, so fading
+    // the colour looks the same as drawing in a faded layer
+    auto colour = mBrush.GetColour();
+    if(mOpacity < 1)
+    {
+        colour = wxColour(colour.Red(), colour.Green(), colour.Blue(),
+                          (unsigned char)(colour.Alpha() * mOpacity + 0.5));
+    }
+
+    auto& cache = GraphicsResourceCache::Get();
+    graphics->SetBrush(cache.GetBrush(graphics, colour));
+    graphics->FillPath(cache.GetPath(graphics, mGeometry, [this, &graphics]() {
+        return mGeometry->CreatePath(graphics);
+    }));
 
     graphics->PopState();
 }
@@ -318,73 +321,64 @@ void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
  */
 void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y)
 {
-    if(mBitmapDirty || mGraphicsBitmap.IsNull())
-    {
-#ifdef WIN32
-        // Implementation of opacity for Windows systems.
-        // Windows does not support transparency layers.
-        if(mOpacity < 1) {
-            // Ensure the image has an alpha map
-            if (!mImage->HasAlpha()) {
-                mImage->InitAlpha();
-            }
-
-            wxImage img = mImage->Copy();
-
-            unsigned char *alpha = img.GetAlpha();
-            for(int i=0; i<img.GetWidth()*img.GetHeight(); i++)
-            {
-                alpha[i] = int(alpha[i] * mOpacity);
-            }
-
-            mGraphicsBitmap = graphics->CreateBitmapFromImage(img);
-        }
-        else
+    if(!mAtlasChecked)
+    {
+        // Draw from an atlas page if the image is on one
+        if(!ImageCache::Get().FindInAtlas(mImage, mAtlasPage, mAtlasRect))
         {
-            mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
+            mAtlasPage = nullptr;
         }
-#else
-        mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
-#endif
-
-        //
-        // Determine the top left and the size of the
-        // region covered by our polygon
-        //
-        mImageClipRegionTopLeft = mPoints[0];
-        auto imageClipRegionBottomRight = mPoints[0];
-
-        for(auto point : mPoints)
-        {
-            if(point.m_x < mImageClipRegionTopLeft.m_x) {
-                mImageClipRegionTopLeft.m_x = point.m_x;
-            }
 
-            if(point.m_y < mImageClipRegionTopLeft.m_y) {
-                mImageClipRegionTopLeft.m_y = point.m_y;
-            }
+        mAtlasChecked = true;
+    }
 
-            if(point.m_x > imageClipRegionBottomRight.m_x) {
-                imageClipRegionBottomRight.m_x = point.m_x;
-            }
+    auto& cache = GraphicsResourceCache::Get();
+    auto image = mAtlasPage != nullptr ? mAtlasPage : mImage;
+    wxGraphicsBitmap bitmap;
 
-            if(point.m_y > imageClipRegionBottomRight.m_y) {
-                imageClipRegionBottomRight.m_y = point.m_y;
-            }
-        }
+    // Partly transparent images are drawn from a faded copy
+    // of the image. Transparency layers are expensive and do
+    // not work on Windows systems. The copies are variants of
+    // the image in the cache, numbered by opacity level, so
+    // every polygon with the image shares them.
+    int level = ImageOpacity::Quantize(mOpacity);
+    if(level == 0)
+    {
+        return;
+    }
 
-        mImageClipRegionSize = imageClipRegionBottomRight - mImageClipRegionTopLeft;
+    if(level < ImageOpacity::Levels)
+    {
+        image = mImage;
+        bitmap = cache.GetBitmap(graphics, mImage, level, [this, &graphics, level]() {
+            FrameProfiler::Scope profile(FrameProfiler::Phase::CreateBitmap);
+            return graphics->CreateBitmapFromImage(ImageOpacity::Create(*mImage, level));
+        });
+    }
+    else
+    {
+        bitmap = cache.GetBitmap(graphics, image);
+    }
 
-        mImageClipRegion.Clear();
-        std::vector<wxPoint> points;
-        for(auto point : mPoints)
-        {
-            points.push_back(wxPoint(int(point.m_x - mImageClipRegionTopLeft.m_x + 0.5),
-                                     int(point.m_y - mImageClipRegionTopLeft.m_y + 0.5)));
-        }
+    // The region covered by our polygon
+    auto topLeft = mGeometry->GetTopLeft();
+    auto size = mGeometry->GetSize();
 
-        mImageClipRegion = wxRegion(points.size(), &points[0]);
-        mBitmapDirty = false;
+    // Where the bitmap goes. An atlas page is placed and scaled so
+    // the part with our image covers the polygon and the clip
+    // region hides the rest of the page.
+    double left = 0;
+    double top = 0;
+    double width = size.m_x;
+    double height = size.m_y;
+    if(image == mAtlasPage)
+    {
+        double scaleX = size.m_x / mAtlasRect.width;
+        double scaleY = size.m_y / mAtlasRect.height;
+        left = -mAtlasRect.x * scaleX;
+        top = -mAtlasRect.y * scaleY;
+        width = mAtlasPage->GetWidth() * scaleX;
+        height = mAtlasPage->GetHeight() * scaleY;
     }
 
     graphics->PushState();
@@ -392,18 +386,18 @@ void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
     graphics->Translate(x, y);
     graphics->Rotate((mRotation + mPhase) * M_PI * 2);
 
-    graphics->Translate(mImageClipRegionTopLeft.m_x, mImageClipRegionTopLeft.m_y);
-    graphics->Clip(mImageClipRegion);
+    graphics->Translate(topLeft.m_x, topLeft.m_y);
+    graphics->Clip(mGeometry->GetClipRegion());
 
     if(mInvertedY)
     {
         // Flip the bitmap upside down
         graphics->Scale(1, -1);
-        graphics->DrawBitmap(mGraphicsBitmap, 0, -mImageClipRegionSize.m_y, mImageClipRegionSize.m_x, mImageClipRegionSize.m_y);
+        graphics->DrawBitmap(bitmap, left, top - size.m_y, width, height);
     }
     else
     {
-        graphics->DrawBitmap(mGraphicsBitmap, 0, 0, mImageClipRegionSize.m_x, mImageClipRegionSize.m_y);
+        graphics->DrawBitmap(bitmap, left, top, width, height);
     }
 
     graphics->PopState();
@@ -483,10 +477,19 @@ bool Polygon::Assert(bool condition, wxString msg, const wxString &url)
     return false;
 }
 
+/**
+ * Get the points that make up the polygon, wherever they are kept
+ * @return Points
+ */
+const std::vector<wxPoint2DDouble>& Polygon::GetPoints() const
+{
+    return mGeometry != nullptr ? mGeometry->GetPoints() : mPoints;
+}
+
 /**
  * Set the opacity of the polygon rendering.
  *
- * Currently only works for images.
+ * Images are drawn at the nearest of ImageOpacity::Levels opacities.
  *
  * @param opacity Opacity from 0 to 1
  */
@@ -502,9 +505,6 @@ void Polygon::SetOpacity(double opacity)
 
         // We have an opacity change
         mOpacity = opacity;
-#ifdef WIN32
-        mBitmapDirty = true;
-#endif
     }
 }
 
@@ -560,7 +560,7 @@ double Polygon::AverageLuminance(int x, int y, int wid, int hit)
  */
 wxPoint2DDouble Polygon::Center()
 {
-    if(mPoints.size() < 3)
+    if(GetPoints().size() < 3)
     {
         // Our polygon MUST have at least three points
         Assert(false,
@@ -574,6 +574,11 @@ wxPoint2DDouble Polygon::Center()
         return wxPoint2DDouble(0, 0);
     }
 
+    if(mGeometry != nullptr)
+    {
+        return mGeometry->GetCenter();
+    }
+
     wxPoint2DDouble center;
     for(auto v : mPoints)
     {
@@ -591,7 +596,7 @@ wxPoint2DDouble Polygon::Center()
  */
 wxRect2DDouble Polygon::BoundingBox()
 {
-    if(mPoints.size() < 3)
+    if(GetPoints().size() < 3)
     {
         // Our polygon MUST have at least three points
         Assert(false,
@@ -606,6 +611,13 @@ wxRect2DDouble Polygon::BoundingBox()
         return wxRect2DDouble(-radius, -radius, radius*2, radius*2);
     }
 
+    if(mGeometry != nullptr)
+    {
+        auto topLeft = mGeometry->GetTopLeft();
+        auto size = mGeometry->GetSize();
+        return wxRect2DDouble(topLeft.m_x, topLeft.m_y, size.m_x, size.m_y);
+    }
+
     auto p1x = mPoints[0].m_x;
     auto p1y = mPoints[0].m_y;
 
@@ -4,7 +4,7 @@
  * @author Anik Momtaz
  * @author Charles Owen
  *
- * @version 1.05
+ * @version 1.10
  *
  * Generic polygon class that is used to make shapes we
  * will use in our project.
@@ -16,6 +16,11 @@
  * 1.03 Put into cse335 namespace, opacity support
  * 1.04 Added Circle function
  * 1.05 Special version that works with inverted Y axis
+ * 1.06 Images are shared through the ImageCache
+ * 1.07 Geometry is shared through PolygonGeometry
+ * 1.08 Images are drawn from an atlas when they are in one
+ * 1.09 Bitmaps, paths and brushes come from the GraphicsResourceCache
+ * 1.10 Opacity uses faded image copies on all systems instead of layers
  */
 
 #pragma once
@@ -26,6 +31,8 @@
 
 namespace cse335 {
 
+    class PolygonGeometry;
+
 /**
  * Generic polygon class that is used to make shapes we
  * will use in our project.
@@ -38,12 +45,13 @@ namespace cse335 {
         void DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y);
         void DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y);
 
-        /// Graphics path to use to draw
-        wxGraphicsPath mPath;
-
-        /// The points that make up the polygon
+        /// The points that make up the polygon, until it is drawn
         std::vector<wxPoint2DDouble> mPoints;
 
+        /// The geometry the points are moved to when the polygon
+        /// is drawn, shared with polygons that have the same points
+        std::shared_ptr<const PolygonGeometry> mGeometry;
+
         /// Set true if this polygon is a circle
         bool mIsCircle = false;
 
@@ -67,20 +75,17 @@ namespace cse335 {
         /// The current mode
         Mode mMode = Mode::Unset;
 
-        /// The basic texture image we load
-        std::unique_ptr<wxImage> mImage;
+        /// The basic texture image we load, shared through the ImageCache
+        std::shared_ptr<const wxImage> mImage;
 
-        /// The graphics bitmap we actually draw
-        wxGraphicsBitmap mGraphicsBitmap;
+        /// The atlas page with our image, if it is in an atlas
+        std::shared_ptr<const wxImage> mAtlasPage;
 
-        /// The image clip region
-        wxRegion mImageClipRegion;
+        /// Rectangle our image occupies on the atlas page
+        wxRect mAtlasRect;
 
-        /// What is the top left point for the clip region?
-        wxPoint2DDouble mImageClipRegionTopLeft;
-
-        /// What is the size of the clip region?
-        wxPoint2DDouble mImageClipRegionSize;
+        /// Set true once we have looked for the image in an atlas
+        bool mAtlasChecked = false;
 
         /// Set true when DrawPolygon is called
         bool mHasDrawn = false;
@@ -88,9 +93,6 @@ namespace cse335 {
         /// Opacity of the polygon - value range to 0 to 1
         double mOpacity = 1.0;
 
-        /// Forces the bitmap to be reloaded
-        bool mBitmapDirty = true;
-
 #ifdef POLYGON_DEFAULT_INVERTEDY
         /// Is the Y axis inverted (positive Y is up)?
         bool mInvertedY = false;
@@ -101,6 +103,8 @@ namespace cse335 {
 
         bool Assert(bool condition, wxString msg, const wxString& url = wxEmptyString);
 
+        const std::vector<wxPoint2DDouble>& GetPoints() const;
+
         //<editor-fold desc="Code to support the deferred assertion message box" defaultstate="collapsed">
         /**
          * Class to display an error message dialog box after a delay
@@ -212,21 +216,21 @@ namespace cse335 {
          * Get the radius if this is a circle
          * @return Radius in the display units
          */
-        double Radius() {return mPoints[0].m_x;}
+        double Radius() {return GetPoints()[0].m_x;}
 
         /**
          * Iterator begin function. Allows for iterating over the
          * vertices of the polygon.
          * @return Vertex iterator
          */
-        std::vector<wxPoint2DDouble>::iterator begin() {return mPoints.begin();}
+        std::vector<wxPoint2DDouble>::const_iterator begin() const {return GetPoints().begin();}
 
         /**
          * Iterator end function. Allows for iterating over the
          * vertices of the polygon.
          * @return Vertex iterator
          */
-        std::vector<wxPoint2DDouble>::iterator end() {return mPoints.end();}
+        std::vector<wxPoint2DDouble>::const_iterator end() const {return GetPoints().end();}
 
         wxPoint2DDouble Center();
         wxRect2DDouble BoundingBox();
@@ -0,0 +1,214 @@
+/**
+ * @file PolygonGeometry.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <wx/thread.h>
+#include "PolygonGeometry.h"
+
+using namespace cse335;
+
+namespace {
+
+/**
+ * The shared geometries, by a hash of their points
+ */
+struct SharedGeometries
+{
+    /// Geometries with each hash. Geometries are released
+    /// when the last polygon using them is destroyed.
+    std::unordered_multimap<size_t, std::weak_ptr<const PolygonGeometry>> mGeometries;
+
+    /// Protects mGeometries
+    std::mutex mMutex;
+};
+
+/**
+ * Get the shared geometries
+ * @return The process-wide table
+ */
+SharedGeometries& GetShared()
+{
+    static SharedGeometries shared;
+    return shared;
+}
+
+/**
+ * Compute a hash of a polygon's points
+ * @param points Points
+ * @param isCircle Is the polygon a circle?
+ * @return Hash value
+ */
+size_t Hash(const std::vector<wxPoint2DDouble>& points, bool isCircle)
+{
+    std::hash<double> hash;
+    size_t value = isCircle ? 1 : 0;
+    for (auto& point : points)
+    {
+        value = value * 31 + hash(point.m_x);
+        value = value * 31 + hash(point.m_y);
+    }
+
+    return value;
+}
+
+/**
+ * Determine if two lists of points are exactly the same
+ * @param a First list
+ * @param b Second list
+ * @return true if they are the same
+ */
+bool SamePoints(const std::vector<wxPoint2DDouble>& a, const std::vector<wxPoint2DDouble>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].m_x != b[i].m_x || a[i].m_y != b[i].m_y)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+/**
+ * Constructor. Use Create unless the geometry must not be shared.
+ * @param points The points that make up the polygon, at least one
+ * @param isCircle Is the polygon a circle?
+ */
+PolygonGeometry::PolygonGeometry(std::vector<wxPoint2DDouble> points, bool isCircle) :
+    mPoints(std::move(points)), mIsCircle(isCircle)
+{
+    mTopLeft = mPoints[0];
+    auto bottomRight = mPoints[0];
+
+    for (auto& point : mPoints)
+    {
+        mTopLeft.m_x = std::min(mTopLeft.m_x, point.m_x);
+        mTopLeft.m_y = std::min(mTopLeft.m_y, point.m_y);
+        bottomRight.m_x = std::max(bottomRight.m_x, point.m_x);
+        bottomRight.m_y = std::max(bottomRight.m_y, point.m_y);
+        mCenter += point;
+    }
+
+    mSize = bottomRight - mTopLeft;
+    mCenter = mCenter / (int)mPoints.size();
+}
+
+/**
+ * Get the geometry for a list of points, sharing it with every
+ * other polygon that has the same points.
+ *
+ * Off the main thread this always returns a new geometry.
+ *
+ * @param points The points that make up the polygon, at least one
+ * @param isCircle Is the polygon a circle?
+ * @return Geometry
+ */
+std::shared_ptr<const PolygonGeometry> PolygonGeometry::Create(std::vector<wxPoint2DDouble> points, bool isCircle)
+{
+    if (!wxIsMainThread())
+    {
+        return std::make_shared<const PolygonGeometry>(std::move(points), isCircle);
+    }
+
+    auto hash = Hash(points, isCircle);
+
+    auto& shared = GetShared();
+    std::lock_guard<std::mutex> lock(shared.mMutex);
+
+    auto range = shared.mGeometries.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; )
+    {
+        auto geometry = iter->second.lock();
+        if (geometry == nullptr)
+        {
+            // Released, so remove it while we are here
+            iter = shared.mGeometries.erase(iter);
+            continue;
+        }
+
+        if (geometry->mIsCircle == isCircle && SamePoints(geometry->mPoints, points))
+        {
+            return geometry;
+        }
+
+        ++iter;
+    }
+
+    auto geometry = std::make_shared<const PolygonGeometry>(std::move(points), isCircle);
+    shared.mGeometries.emplace(hash, geometry);
+    return geometry;
+}
+
+/**
+ * Get the number of shared geometries still in use
+ * @return Number of geometries
+ */
+size_t PolygonGeometry::GetSharedCount()
+{
+    auto& shared = GetShared();
+    std::lock_guard<std::mutex> lock(shared.mMutex);
+
+    size_t count = 0;
+    for (auto& geometry : shared.mGeometries)
+    {
+        if (!geometry.second.expired())
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Get the region an image is clipped to, relative to the top left
+ * of the box that encloses the points
+ * @return Clip region
+ */
+const wxRegion& PolygonGeometry::GetClipRegion() const
+{
+    if (!mClipRegion.IsOk())
+    {
+        std::vector<wxPoint> points;
+        for (auto& point : mPoints)
+        {
+            points.push_back(wxPoint(int(point.m_x - mTopLeft.m_x + 0.5),
+                                     int(point.m_y - mTopLeft.m_y + 0.5)));
+        }
+
+        mClipRegion = wxRegion(points.size(), &points[0]);
+    }
+
+    return mClipRegion;
+}
+
+/**
+ * Create a closed graphics path through the points
+ * @param graphics Graphics context the path will be drawn on
+ * @return Graphics path
+ */
+wxGraphicsPath PolygonGeometry::CreatePath(std::shared_ptr<wxGraphicsContext> graphics) const
+{
+    auto path = graphics->CreatePath();
+    path.MoveToPoint(mPoints[0].m_x, mPoints[0].m_y);
+    for (size_t i = 1; i < mPoints.size(); i++)
+    {
+        path.AddLineToPoint(mPoints[i].m_x, mPoints[i].m_y);
+    }
+    path.CloseSubpath();
+
+    return path;
+}
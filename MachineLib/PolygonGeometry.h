@@ -0,0 +1,102 @@
+/**
+ * @file PolygonGeometry.h
+ * @author Aditya Menon
+ *
+ * Immutable geometry shared by polygons with the same points
+ */
+
+#ifndef POLYGONGEOMETRY_H
+#define POLYGONGEOMETRY_H
+
+#include <memory>
+#include <vector>
+
+namespace cse335 {
+
+/**
+ * Immutable geometry shared by polygons with the same points.
+ *
+ * Many polygons have exactly the same shape: posts of the same
+ * size, pulleys of the same radius. Create hands out one geometry
+ * for each distinct list of points, so the points, the bounding
+ * box and center computed from them and the image clip region are
+ * built and stored once, no matter how many polygons use them. The
+ * graphics path is kept in the GraphicsResourceCache, keyed by the
+ * geometry.
+ *
+ * Geometries are only shared on the main thread, since wxWidgets
+ * reference counts are not atomic. Polygons drawn on other threads
+ * get a geometry of their own. The clip region is created the first
+ * time it is asked for, so a geometry must only be drawn on the
+ * thread that created it.
+ */
+class PolygonGeometry {
+private:
+    /// The points that make up the polygon
+    std::vector<wxPoint2DDouble> mPoints;
+
+    /// Is the polygon a circle?
+    bool mIsCircle;
+
+    /// Top left of the box that encloses the points
+    wxPoint2DDouble mTopLeft;
+
+    /// Size of the box that encloses the points
+    wxPoint2DDouble mSize;
+
+    /// Average of the points
+    wxPoint2DDouble mCenter;
+
+    /// Image clip region, relative to mTopLeft, created when first used
+    mutable wxRegion mClipRegion;
+
+public:
+    PolygonGeometry(std::vector<wxPoint2DDouble> points, bool isCircle);
+
+    /// Copy constructor (disabled)
+    PolygonGeometry(const PolygonGeometry &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const PolygonGeometry &) = delete;
+
+    static std::shared_ptr<const PolygonGeometry> Create(std::vector<wxPoint2DDouble> points, bool isCircle);
+
+    static size_t GetSharedCount();
+
+    /**
+     * Get the points that make up the polygon
+     * @return Points
+     */
+    const std::vector<wxPoint2DDouble>& GetPoints() const { return mPoints; }
+
+    /**
+     * Is the polygon a circle?
+     * @return true if the polygon is a circle
+     */
+    bool IsCircle() const { return mIsCircle; }
+
+    /**
+     * Get the top left of the box that encloses the points
+     * @return Top left point
+     */
+    wxPoint2DDouble GetTopLeft() const { return mTopLeft; }
+
+    /**
+     * Get the size of the box that encloses the points
+     * @return Width and height
+     */
+    wxPoint2DDouble GetSize() const { return mSize; }
+
+    /**
+     * Get the average of the points
+     * @return Center point
+     */
+    wxPoint2DDouble GetCenter() const { return mCenter; }
+
+    const wxRegion& GetClipRegion() const;
+    wxGraphicsPath CreatePath(std::shared_ptr<wxGraphicsContext> graphics) const;
+};
+
+}
+
+#endif //POLYGONGEOMETRY_H
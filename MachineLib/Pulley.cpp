@@ -40,10 +40,6 @@ void Pulley::ConnectBelt(Pulley* pulley)
         return;
     }
     
-    // Add the pulley to our connected pulleys
-    mConnectedPulleys.push_back(pulley);
-    pulley->mDrivingPulley = this;
-    
     // Important: Connect source and sink properly
     if (mSource != nullptr && pulley->GetSink() != nullptr)
     {
@@ -93,12 +89,6 @@ void Pulley::ConnectPulley(Pulley* pulley)
         return;
     }
     
-    // Add the pulley to our connected pulleys
-    mConnectedPulleys.push_back(pulley);
-    
-    // Set this pulley as the driving pulley for the connected pulley
-    pulley->mDrivingPulley = this;
-    
     // IMPORTANT: For pulleys on the same shaft, they rotate together directly
     // The difference from ConnectBelt is we don't adjust for radius differences
     if (mSource != nullptr && pulley->GetSink() != nullptr)
@@ -125,29 +115,8 @@ void Pulley::SetTime(double time)
         GetBase()->SetRotation(rotation + mPhase * 2 * M_PI);
     }
     
-    // Update the source rotation to drive other components
-    if (mSource != nullptr)
-    {
-        mSource->SetRotation(rotation);
-    }
-    
-    // Make sure to propagate rotation to all connected pulleys
-    for (auto pulley : mConnectedPulleys)
-    {
-        if (pulley != nullptr && pulley != mDrivingPulley)
-        {
-            pulley->SetCurrentRotation(rotation);
-        }
-    }
-    
-    // Directly update any non-pulley components we're driving
-    for (auto component : mDrivenComponents)
-    {
-        if (component != nullptr)
-        {
-            component->SetCurrentRotation(rotation);
-        }
-    }
+    // Propagation to the components we drive is done
+    // by the machine's drive graph
 }
 
 /**
@@ -196,7 +165,7 @@ void Pulley::AddSink(Component* sink)
         
         // If not a pulley, store it directly for manual rotation updates
         // This handles Shape objects which don't have proper Sink implementations
-        // We'll update these directly during SetTime
+        // The drive graph updates these directly
         if (mSource != nullptr)
         {
             // Just store the component for rotation updates
@@ -206,29 +175,25 @@ void Pulley::AddSink(Component* sink)
 }
 
 /**
- * Override SetCurrentRotation to propagate rotation to connected components
- * @param rotation Rotation in radians
+ * Get the components driven by this pulley, both through
+ * its source and directly
+ * @return Driven components
  */
-void Pulley::SetCurrentRotation(double rotation)
+std::vector<Component*> Pulley::GetDrivenComponents()
 {
-    // Apply speed multiplier to the received rotation
-    double adjustedRotation = rotation * mSpeedMultiplier;
-    
-    // Call the base class implementation with the adjusted rotation
-    Component::SetCurrentRotation(adjustedRotation);
+    std::vector<Component*> driven;
     
-    // Now propagate this adjusted rotation to our source
+    // Pulleys connected by belt or shaft are driven through our source
     if (mSource != nullptr)
     {
-        mSource->SetRotation(adjustedRotation);
-    }
-    
-    // Directly update any other components we're driving
-    for (auto component : mDrivenComponents)
-    {
-        if (component != nullptr)
+        for (auto sink : mSource->GetSinks())
         {
-            component->SetCurrentRotation(adjustedRotation);
+            driven.push_back(sink->GetComponent());
         }
     }
-} 
\ No newline at end of file
+    
+    // Components without a sink of their own are driven directly
+    driven.insert(driven.end(), mDrivenComponents.begin(), mDrivenComponents.end());
+    
+    return driven;
+}
\ No newline at end of file
@@ -31,12 +31,6 @@ private:
     /// Speed multiplier (1.0 = same speed as source)
     double mSpeedMultiplier = 1.0;
     
-    /// The pulley driving this one
-    Pulley* mDrivingPulley = nullptr;
-    
-    /// Pulleys connected to this one
-    std::vector<Pulley*> mConnectedPulleys;
-    
     /// Components directly driven by this pulley (not via Source/Sink)
     std::vector<Component*> mDrivenComponents;
     
@@ -73,7 +67,7 @@ public:
      * Get the speed multiplier for this pulley
      * @return Speed multiplier
      */
-    double GetSpeedMultiplier() const { return mSpeedMultiplier; }
+    double GetSpeedMultiplier() const override { return mSpeedMultiplier; }
     
     /**
      * Get the pulley sink for connections
@@ -125,10 +119,11 @@ public:
     double GetCurrentRotation() { return Component::GetCurrentRotation(); }
     
     /**
-     * Override to propagate rotation to connected components
-     * @param rotation Rotation in radians
+     * Get the components driven by this pulley, both through
+     * its source and directly
+     * @return Driven components
      */
-    void SetCurrentRotation(double rotation) override;
+    std::vector<Component*> GetDrivenComponents() override;
 };
 
 #endif //PULLEY_H 
@@ -23,6 +23,7 @@ Shape::Shape()
 void Shape::AddPoint(wxPoint point)
 {
     GetBase()->AddPoint(point.x, point.y);
+    StaticChanged();
 }
 
 /**
@@ -32,6 +33,7 @@ void Shape::AddPoint(wxPoint point)
 void Shape::SetColor(wxColor color)
 {
     GetBase()->SetColor(color);
+    StaticChanged();
 }
 
 /**
@@ -45,6 +45,12 @@ public:
      * @return Rotation in radians
      */
     double GetRotation() const { return mRotation; }
+    
+    /**
+     * Get the sinks driven by this source
+     * @return Collection of sinks
+     */
+    const std::vector<Sink*>& GetSinks() const { return mSinks; }
 };
 
 #endif //SOURCE_H 
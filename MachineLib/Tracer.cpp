@@ -0,0 +1,265 @@
+/**
+ * @file Tracer.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include <wx/thread.h>
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include "Tracer.h"
+
+/**
+ * Hands a buffer back to the tracer when its thread exits,
+ * so threads that come and go reuse buffers rather than
+ * adding new ones.
+ */
+struct ThreadBufferHolder
+{
+    /// Buffer the thread records into
+    Tracer::Buffer* mBuffer = nullptr;
+
+    /// Destructor, releases the buffer
+    ~ThreadBufferHolder()
+    {
+        if (mBuffer != nullptr)
+        {
+            mBuffer->mInUse.store(false, std::memory_order_release);
+        }
+    }
+};
+
+/// Buffer for the calling thread
+static thread_local ThreadBufferHolder ThreadBuffer;
+
+/**
+ * Write a string as a JSON string literal
+ * @param stream Stream to write to
+ * @param str String to write
+ */
+static void WriteJsonString(std::ostream& stream, const char* str)
+{
+    stream << '"';
+    for (auto p = str; *p != 0; p++)
+    {
+        if (*p == '"' || *p == '\\')
+        {
+            stream << '\\';
+        }
+        stream << *p;
+    }
+    stream << '"';
+}
+
+/**
+ * Constructor, private so the only instance is the one from Get
+ */
+Tracer::Tracer() : mOrigin(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * Get the process-wide tracer
+ * @return The tracer
+ */
+Tracer& Tracer::Get()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+/**
+ * Get the buffer for the calling thread, assigning one
+ * the first time the thread records
+ * @return Buffer for this thread
+ */
+Tracer::Buffer* Tracer::GetThreadBuffer()
+{
+    if (ThreadBuffer.mBuffer != nullptr)
+    {
+        return ThreadBuffer.mBuffer;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Reuse the buffer of a thread that has exited
+    for (auto& buffer : mBuffers)
+    {
+        bool inUse = false;
+        if (buffer->mInUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+        {
+            buffer->mMainThread = wxIsMainThread();
+            ThreadBuffer.mBuffer = buffer.get();
+            return buffer.get();
+        }
+    }
+
+    auto buffer = std::make_unique<Buffer>();
+    buffer->mThreadId = int(mBuffers.size()) + 1;
+    buffer->mInUse = true;
+    buffer->mMainThread = wxIsMainThread();
+    ThreadBuffer.mBuffer = buffer.get();
+    mBuffers.push_back(std::move(buffer));
+    return ThreadBuffer.mBuffer;
+}
+
+/**
+ * Record a complete event for the calling thread
+ * @param name Event name, a string literal
+ * @param start Time the event began
+ * @param end Time the event ended
+ * @param argName Argument name, a string literal, or nullptr for none
+ * @param arg Argument value
+ */
+void Tracer::Record(const char* name, std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end, const char* argName, long long arg)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    auto buffer = GetThreadBuffer();
+
+    // Only this thread writes the buffer, so plain loads and
+    // stores of the counters are enough on this side
+    auto count = buffer->mCount.load(std::memory_order_relaxed);
+    buffer->mStarted.store(count + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto& event = buffer->mEvents[count % BufferSize];
+    event.mName.store(name, std::memory_order_relaxed);
+    event.mStart.store(duration_cast<nanoseconds>(start - mOrigin).count(), std::memory_order_relaxed);
+    event.mDuration.store(duration_cast<nanoseconds>(end - start).count(), std::memory_order_relaxed);
+    event.mArgName.store(argName, std::memory_order_relaxed);
+    event.mArg.store(arg, std::memory_order_relaxed);
+
+    buffer->mCount.store(count + 1, std::memory_order_release);
+}
+
+/**
+ * Write the recorded events as Chrome Trace Event Format JSON
+ * @param stream Stream to write to
+ */
+void Tracer::Write(std::ostream& stream) const
+{
+    /// A copy of an event taken from a buffer
+    struct Copy
+    {
+        const char* mName;
+        long long mStart;
+        long long mDuration;
+        const char* mArgName;
+        long long mArg;
+    };
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for (auto& buffer : mBuffers)
+    {
+        // Name the thread's row in the viewer
+        stream << (first ? "\n" : ",\n");
+        first = false;
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->mThreadId
+               << ",\"args\":{\"name\":\"";
+        if (buffer->mMainThread)
+        {
+            stream << "Main";
+        }
+        else
+        {
+            stream << "Worker " << buffer->mThreadId;
+        }
+        stream << "\"}}";
+
+        auto count = buffer->mCount.load(std::memory_order_acquire);
+        auto begin = count > BufferSize ? count - BufferSize : 0;
+
+        std::vector<Copy> events;
+        events.reserve(count - begin);
+        for (auto i = begin; i < count; i++)
+        {
+            auto& event = buffer->mEvents[i % BufferSize];
+            events.push_back({event.mName.load(std::memory_order_relaxed),
+                              event.mStart.load(std::memory_order_relaxed),
+                              event.mDuration.load(std::memory_order_relaxed),
+                              event.mArgName.load(std::memory_order_relaxed),
+                              event.mArg.load(std::memory_order_relaxed)});
+        }
+
+        // Drop any slots the recording thread started
+        // overwriting while we were copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto started = buffer->mStarted.load(std::memory_order_relaxed);
+        size_t skip = started > begin + BufferSize ? size_t(started - begin - BufferSize) : 0;
+
+        for (size_t i = skip; i < events.size(); i++)
+        {
+            auto& event = events[i];
+            stream << ",\n{\"name\":";
+            WriteJsonString(stream, event.mName);
+            stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->mThreadId
+                   << ",\"ts\":" << event.mStart / 1000 << "." << event.mStart / 100 % 10
+                   << ",\"dur\":" << event.mDuration / 1000 << "." << event.mDuration / 100 % 10;
+            if (event.mArgName != nullptr)
+            {
+                stream << ",\"args\":{";
+                WriteJsonString(stream, event.mArgName);
+                stream << ":" << event.mArg << "}";
+            }
+            stream << "}";
+        }
+    }
+
+    stream << "\n]}\n";
+}
+
+/**
+ * Write the recorded events to a Chrome Trace Event Format JSON file
+ * @param filename File to write
+ * @return true if the file was written
+ */
+bool Tracer::Write(const std::wstring& filename) const
+{
+    std::ofstream file(wxString(filename).fn_str());
+    if (!file)
+    {
+        return false;
+    }
+
+    Write(file);
+    return file.good();
+}
+
+/**
+ * Discard every recorded event. Only call this when
+ * no other thread is recording.
+ */
+void Tracer::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& buffer : mBuffers)
+    {
+        buffer->mCount = 0;
+        buffer->mStarted = 0;
+    }
+}
+
+/**
+ * Get the number of events currently held in the buffers
+ * @return Number of events
+ */
+size_t Tracer::GetEventCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t total = 0;
+    for (auto& buffer : mBuffers)
+    {
+        auto count = buffer->mCount.load(std::memory_order_acquire);
+        total += size_t(std::min(count, (unsigned long long)BufferSize));
+    }
+
+    return total;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file Tracer.h
+ * @author Aditya Menon
+ *
+ * Records timed events for viewing in a trace viewer
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Records timed events for viewing in a trace viewer.
+ *
+ * Code that should appear in a trace declares a Tracer::Scope at
+ * the top of the block. While tracing is enabled, each scope
+ * becomes one complete event with its start time and duration.
+ *
+ * Every thread records into its own fixed size ring buffer, so
+ * recording takes no lock and a long session keeps only the most
+ * recent events. The buffers can be written at any time, even
+ * while other threads are recording, as a Chrome Trace Event
+ * Format JSON file that chrome://tracing or Perfetto can open.
+ *
+ * Event and argument names must be string literals, since only
+ * the pointer is stored.
+ */
+class Tracer {
+public:
+    /// Number of events each thread keeps
+    static constexpr size_t BufferSize = 1 << 16;
+
+    /**
+     * Records the block of code it is declared in as an event
+     */
+    class Scope
+    {
+    private:
+        /// Event name
+        const char* mName;
+
+        /// Argument name or nullptr for none
+        const char* mArgName;
+
+        /// Argument value
+        long long mArg;
+
+        /// True if tracing was enabled when the scope began
+        bool mActive;
+
+        /// Time the scope began
+        std::chrono::steady_clock::time_point mStart;
+
+    public:
+        /**
+         * Constructor, starts timing if tracing is enabled
+         * @param name Event name, a string literal
+         * @param argName Argument name, a string literal, or nullptr for none
+         * @param arg Argument value
+         */
+        explicit Scope(const char* name, const char* argName = nullptr, long long arg = 0) :
+            mName(name), mArgName(argName), mArg(arg), mActive(Tracer::Get().IsEnabled())
+        {
+            if (mActive)
+            {
+                mStart = std::chrono::steady_clock::now();
+            }
+        }
+
+        /**
+         * Destructor, records the event
+         */
+        ~Scope()
+        {
+            if (mActive)
+            {
+                Tracer::Get().Record(mName, mStart, std::chrono::steady_clock::now(), mArgName, mArg);
+            }
+        }
+
+        /// Copy constructor (disabled)
+        Scope(const Scope &) = delete;
+
+        /// Assignment operator (disabled)
+        void operator=(const Scope &) = delete;
+    };
+
+    /// One recorded event. The fields are atomic so the
+    /// buffer can be read while its thread is writing.
+    struct Event
+    {
+        /// Event name
+        std::atomic<const char*> mName{nullptr};
+
+        /// Start time in nanoseconds since the tracer was created
+        std::atomic<long long> mStart{0};
+
+        /// Duration in nanoseconds
+        std::atomic<long long> mDuration{0};
+
+        /// Argument name or nullptr for none
+        std::atomic<const char*> mArgName{nullptr};
+
+        /// Argument value
+        std::atomic<long long> mArg{0};
+    };
+
+    /// The ring buffer of one thread
+    struct Buffer
+    {
+        /// Thread id written to the trace
+        int mThreadId = 0;
+
+        /// True if the main thread records into this buffer
+        bool mMainThread = false;
+
+        /// True while a thread is recording into this buffer
+        std::atomic<bool> mInUse{false};
+
+        /// Number of events ever recorded; the next one goes
+        /// in mEvents[mCount % BufferSize]
+        std::atomic<unsigned long long> mCount{0};
+
+        /// Number of events ever started. This runs one ahead of
+        /// mCount while an event is being written, so a reader
+        /// can tell which slots may have been overwritten.
+        std::atomic<unsigned long long> mStarted{0};
+
+        /// The events
+        std::unique_ptr<Event[]> mEvents{new Event[BufferSize]};
+    };
+
+private:
+    /// True while recording
+    std::atomic<bool> mEnabled{false};
+
+    /// Time zero for the trace
+    std::chrono::steady_clock::time_point mOrigin;
+
+    /// Every buffer ever handed to a thread
+    std::vector<std::unique_ptr<Buffer>> mBuffers;
+
+    /// Protects mBuffers
+    mutable std::mutex mMutex;
+
+    /**
+     * Constructor, private so the only instance is the one from Get
+     */
+    Tracer();
+
+    /**
+     * Get the buffer for the calling thread, assigning one
+     * the first time the thread records
+     * @return Buffer for this thread
+     */
+    Buffer* GetThreadBuffer();
+
+public:
+    /// Copy constructor (disabled)
+    Tracer(const Tracer &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const Tracer &) = delete;
+
+    /**
+     * Get the process-wide tracer
+     * @return The tracer
+     */
+    static Tracer& Get();
+
+    /**
+     * Record a complete event for the calling thread
+     * @param name Event name, a string literal
+     * @param start Time the event began
+     * @param end Time the event ended
+     * @param argName Argument name, a string literal, or nullptr for none
+     * @param arg Argument value
+     */
+    void Record(const char* name, std::chrono::steady_clock::time_point start,
+            std::chrono::steady_clock::time_point end, const char* argName = nullptr, long long arg = 0);
+
+    /**
+     * Write the recorded events as Chrome Trace Event Format JSON
+     * @param stream Stream to write to
+     */
+    void Write(std::ostream& stream) const;
+
+    /**
+     * Write the recorded events to a Chrome Trace Event Format JSON file
+     * @param filename File to write
+     * @return true if the file was written
+     */
+    bool Write(const std::wstring& filename) const;
+
+    /**
+     * Discard every recorded event. Only call this when
+     * no other thread is recording.
+     */
+    void Clear();
+
+    /**
+     * Get the number of events currently held in the buffers
+     * @return Number of events
+     */
+    size_t GetEventCount() const;
+
+    /**
+     * Start or stop recording
+     * @param enabled True to record events
+     */
+    void SetEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * Determine if events are being recorded
+     * @return True if enabled
+     */
+    bool IsEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+};
+
+#endif //TRACER_H
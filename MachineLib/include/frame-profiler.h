@@ -0,0 +1,13 @@
+/**
+ * @file frame-profiler.h
+ * @author Aditya Menon
+ *
+ * Header for the frame profiler shared with users of the machines library.
+ */
+
+#ifndef MACHINELIB_FRAME_PROFILER_H
+#define MACHINELIB_FRAME_PROFILER_H
+
+#include "../FrameProfiler.h"
+
+#endif //MACHINELIB_FRAME_PROFILER_H
@@ -0,0 +1,13 @@
+/**
+ * @file graphics-resource-cache.h
+ * @author Aditya Menon
+ *
+ * Header for the graphics resource cache shared with users of the machines library.
+ */
+
+#ifndef MACHINELIB_GRAPHICS_RESOURCE_CACHE_H
+#define MACHINELIB_GRAPHICS_RESOURCE_CACHE_H
+
+#include "../GraphicsResourceCache.h"
+
+#endif //MACHINELIB_GRAPHICS_RESOURCE_CACHE_H
@@ -0,0 +1,13 @@
+/**
+ * @file image-cache.h
+ * @author Aditya Menon
+ *
+ * Header for the image cache shared with users of the machines library.
+ */
+
+#ifndef MACHINELIB_IMAGE_CACHE_H
+#define MACHINELIB_IMAGE_CACHE_H
+
+#include "../ImageCache.h"
+
+#endif //MACHINELIB_IMAGE_CACHE_H
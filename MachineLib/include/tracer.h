@@ -0,0 +1,13 @@
+/**
+ * @file tracer.h
+ * @author Aditya Menon
+ *
+ * Header for the event tracer shared with users of the machines library.
+ */
+
+#ifndef MACHINELIB_TRACER_H
+#define MACHINELIB_TRACER_H
+
+#include "../Tracer.h"
+
+#endif //MACHINELIB_TRACER_H
@@ -0,0 +1,76 @@
+/**
+ * @file BubbleBlowerTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <BubbleBlower.h>
+
+TEST(BubbleBlowerTest, Seek)
+{
+    BubbleBlower blower;
+    blower.SetRotationRate(2.0);
+    blower.SetSeed(123);
+
+    // Play forward to 10 seconds
+    blower.SetTime(10.0);
+    ASSERT_EQ(300, blower.GetStep());
+    auto count = blower.GetBubbleCount();
+    ASSERT_GT(count, 0u);
+
+    // Scrub back and then forward again
+    blower.SetTime(0.5);
+    ASSERT_EQ(15, blower.GetStep());
+    blower.SetTime(10.0);
+    ASSERT_EQ(count, blower.GetBubbleCount());
+
+    // Going back to the start clears the bubbles
+    blower.SetTime(0);
+    ASSERT_EQ(0u, blower.GetBubbleCount());
+}
+
+TEST(BubbleBlowerTest, Seed)
+{
+    BubbleBlower blower1;
+    blower1.SetRotationRate(2.0);
+    blower1.SetSeed(7);
+
+    BubbleBlower blower2;
+    blower2.SetRotationRate(2.0);
+    blower2.SetSeed(7);
+
+    // Stepping frame by frame and seeking directly agree
+    for (int frame = 1; frame <= 200; frame++)
+    {
+        blower1.SetTime(frame / 30.0);
+    }
+    blower2.SetTime(200 / 30.0);
+
+    ASSERT_EQ(blower1.GetStep(), blower2.GetStep());
+    ASSERT_EQ(blower1.GetBubbleCount(), blower2.GetBubbleCount());
+}
+
+TEST(BubbleBlowerTest, SnapshotsBounded)
+{
+    BubbleBlower blower1;
+    blower1.SetRotationRate(2.0);
+    blower1.SetSeed(11);
+
+    // An hour of machine time would be 3600 snapshots at one per second
+    blower1.SetTime(3600.0);
+    ASSERT_LE(blower1.GetSnapshotCount(), 64u);
+    ASSERT_GT(blower1.GetSnapshotCount(), 1u);
+
+    // Seeking back through the thinned snapshots still gives the same bubbles
+    BubbleBlower blower2;
+    blower2.SetRotationRate(2.0);
+    blower2.SetSeed(11);
+    blower2.SetTime(1234.5);
+
+    blower1.SetTime(1234.5);
+    ASSERT_EQ(blower2.GetStep(), blower1.GetStep());
+    ASSERT_EQ(blower2.GetBubbleCount(), blower1.GetBubbleCount());
+}
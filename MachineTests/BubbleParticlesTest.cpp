@@ -0,0 +1,106 @@
+/**
+ * @file BubbleParticlesTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <BubbleParticles.h>
+#include <BubbleKernel.h>
+
+TEST(BubbleParticlesTest, Cull)
+{
+    BubbleParticles bubbles;
+    bubbles.Add(wxPoint2DDouble(0, 0), wxPoint2DDouble(0, 0), 1);
+    bubbles.Add(wxPoint2DDouble(900, 0), wxPoint2DDouble(0, 0), 2);
+    bubbles.Add(wxPoint2DDouble(10, 20), wxPoint2DDouble(0, 0), 3);
+    bubbles.Add(wxPoint2DDouble(0, -700), wxPoint2DDouble(0, 0), 4);
+    ASSERT_EQ(4u, bubbles.GetCount());
+
+    // Bounds are tested as part of the update
+    bubbles.SetBounds(800, 600);
+    bubbles.Update(0);
+    ASSERT_FALSE(bubbles.IsAlive(1));
+    ASSERT_FALSE(bubbles.IsAlive(3));
+
+    // The bubble at the end moves into the first removed slot
+    bubbles.Cull();
+    ASSERT_EQ(2u, bubbles.GetCount());
+    ASSERT_NEAR(0, bubbles.GetPosition(0).m_x, 0.0001);
+    ASSERT_NEAR(10, bubbles.GetPosition(1).m_x, 0.0001);
+    ASSERT_NEAR(20, bubbles.GetPosition(1).m_y, 0.0001);
+}
+
+TEST(BubbleParticlesTest, Update)
+{
+    BubbleParticles bubbles;
+    bubbles.Add(wxPoint2DDouble(0, 0), wxPoint2DDouble(30, -60), 0);
+
+    bubbles.Update(0.5);
+    ASSERT_NEAR(15, bubbles.GetPosition(0).m_x, 0.0001);
+    ASSERT_NEAR((-60 + 0.5) * 0.5, bubbles.GetPosition(0).m_y, 0.0001);
+
+    // Bubbles only grow until they pop, and popped bubbles are culled
+    for (int i = 0; i < 10000 && bubbles.GetCount() > 0; i++)
+    {
+        ASSERT_LE(bubbles.GetRadius(0), BubbleParticles::BubbleMaximumRadius);
+        bubbles.Update(0);
+        bubbles.Cull();
+    }
+    ASSERT_EQ(0u, bubbles.GetCount());
+}
+
+TEST(BubbleParticlesTest, Kernels)
+{
+    const size_t count = 37;
+
+    // Every supported kernel must match the scalar kernel
+    for (auto type : {BubbleKernel::Type::SSE2, BubbleKernel::Type::AVX2})
+    {
+        if (!BubbleKernel::IsSupported(type))
+        {
+            continue;
+        }
+
+        std::vector<float> x[2], y[2], vx[2], vy[2], radius[2];
+        std::vector<uint32_t> key;
+        std::vector<int32_t> alive[2];
+        for (size_t i = 0; i < count; i++)
+        {
+            for (int k = 0; k < 2; k++)
+            {
+                x[k].push_back(float(i) * 20 - 360);
+                y[k].push_back(float(i) * -3);
+                vx[k].push_back(float(i % 5) * 10 - 20);
+                vy[k].push_back(-30);
+                radius[k].push_back(15);
+                alive[k].push_back(1);
+            }
+            key.push_back(uint32_t(i * 7919));
+        }
+
+        BubbleKernelData data[2];
+        for (int k = 0; k < 2; k++)
+        {
+            data[k] = {x[k].data(), y[k].data(), vx[k].data(), vy[k].data(),
+                       radius[k].data(), key.data(), alive[k].data(), count};
+        }
+
+        for (uint32_t counter = 0; counter < 200; counter++)
+        {
+            BubbleKernelStep step = {1.0f / 30, 1.0f / 30, counter, 1 << 21, 0.5f, 30, 400, 300};
+            BubbleKernel::Update(BubbleKernel::Type::Scalar, data[0], step);
+            BubbleKernel::Update(type, data[1], step);
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(alive[0][i], alive[1][i]) << BubbleKernel::GetName(type);
+            ASSERT_EQ(radius[0][i], radius[1][i]) << BubbleKernel::GetName(type);
+            ASSERT_NEAR(x[0][i], x[1][i], 0.001) << BubbleKernel::GetName(type);
+            ASSERT_NEAR(y[0][i], y[1][i], 0.001) << BubbleKernel::GetName(type);
+        }
+    }
+}
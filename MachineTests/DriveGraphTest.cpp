@@ -0,0 +1,99 @@
+/**
+ * @file DriveGraphTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <DriveGraph.h>
+#include <Motor.h>
+#include <Pulley.h>
+#include <Shape.h>
+
+TEST(DriveGraphTest, SinglePass)
+{
+    auto motor = std::make_shared<Motor>();
+    motor->SetSpeed(1.0);
+
+    auto pulley1 = std::make_shared<Pulley>(10);
+    auto pulley2 = std::make_shared<Pulley>(20);
+    pulley2->SetSpeedMultiplier(0.5);
+    auto flag = std::make_shared<Shape>();
+
+    motor->AddSink(pulley1.get());
+    pulley1->ConnectBelt(pulley2.get());
+    pulley2->AddSink(flag.get());
+
+    // Deliberately listed with the driven components first
+    std::vector<std::shared_ptr<Component>> components = {flag, pulley2, pulley1, motor};
+
+    DriveGraph graph;
+    ASSERT_TRUE(graph.Compile(components));
+    ASSERT_EQ(0u, graph.GetCycleCount());
+    ASSERT_EQ(4u, graph.GetNodeCount());
+
+    graph.Evaluate(2.5);
+
+    double motorRotation = 2.5 * 1.0 / 5.0 * 2 * M_PI;
+    ASSERT_NEAR(motorRotation, motor->GetCurrentRotation(), 0.0001);
+    ASSERT_NEAR(motorRotation, pulley1->GetCurrentRotation(), 0.0001);
+    ASSERT_NEAR(motorRotation * 0.5, pulley2->GetCurrentRotation(), 0.0001);
+    ASSERT_NEAR(motorRotation * 0.5, flag->GetCurrentRotation(), 0.0001);
+}
+
+TEST(DriveGraphTest, EvaluateRotations)
+{
+    auto motor = std::make_shared<Motor>();
+    motor->SetSpeed(2.0);
+
+    auto pulley1 = std::make_shared<Pulley>(10);
+    pulley1->SetSpeedMultiplier(0.5);
+    auto pulley2 = std::make_shared<Pulley>(20);
+    pulley2->SetSpeedMultiplier(3.0);
+
+    // Not connected to anything, so keeps its own rotation
+    auto shape = std::make_shared<Shape>();
+    shape->SetCurrentRotation(-0.3);
+
+    motor->AddSink(pulley1.get());
+    pulley1->ConnectPulley(pulley2.get());
+
+    std::vector<std::shared_ptr<Component>> components = {motor, pulley1, pulley2, shape};
+
+    DriveGraph graph;
+    graph.Compile(components);
+
+    // A far seek gives the same result as stepping the machine there
+    std::vector<double> rotations;
+    graph.EvaluateRotations(300.0, rotations);
+    graph.Evaluate(300.0);
+
+    ASSERT_EQ(4u, rotations.size());
+    ASSERT_NEAR(motor->GetCurrentRotation(), rotations[0], 0.0001);
+    ASSERT_NEAR(pulley1->GetCurrentRotation(), rotations[1], 0.0001);
+    ASSERT_NEAR(pulley2->GetCurrentRotation(), rotations[2], 0.0001);
+    ASSERT_NEAR(-0.3, rotations[3], 0.0001);
+
+    double motorRotation = 300.0 * 2.0 / 5.0 * 2 * M_PI;
+    ASSERT_NEAR(motorRotation * 1.5, rotations[2], 0.0001);
+}
+
+TEST(DriveGraphTest, Cycle)
+{
+    auto pulley1 = std::make_shared<Pulley>(10);
+    auto pulley2 = std::make_shared<Pulley>(10);
+
+    pulley1->ConnectBelt(pulley2.get());
+    pulley2->ConnectBelt(pulley1.get());
+
+    std::vector<std::shared_ptr<Component>> components = {pulley1, pulley2};
+
+    DriveGraph graph;
+    ASSERT_FALSE(graph.Compile(components));
+    ASSERT_EQ(2u, graph.GetCycleCount());
+
+    // Components in a cycle are still evaluated
+    graph.Evaluate(1.0);
+}
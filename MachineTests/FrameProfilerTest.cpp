@@ -0,0 +1,69 @@
+/**
+ * @file FrameProfilerTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <FrameProfiler.h>
+
+using namespace std::chrono;
+
+TEST(FrameProfilerTest, Disabled)
+{
+    auto& profiler = FrameProfiler::Get();
+    profiler.Reset();
+    profiler.SetEnabled(false);
+
+    {
+        FrameProfiler::Scope scope(FrameProfiler::Phase::DrawPolygon);
+    }
+    profiler.EndFrame();
+
+    auto stats = profiler.GetStats(FrameProfiler::Phase::DrawPolygon);
+    ASSERT_EQ(0, stats.mCalls);
+    ASSERT_EQ(0, stats.mP99);
+}
+
+TEST(FrameProfilerTest, Stats)
+{
+    auto& profiler = FrameProfiler::Get();
+    profiler.Reset();
+    profiler.SetEnabled(true);
+    profiler.SetWindow(100);
+
+    // Frames taking 1ms to 100ms, each in two calls
+    for (int frame = 1; frame <= 100; frame++)
+    {
+        profiler.Add(FrameProfiler::Phase::Place, microseconds(frame * 500));
+        profiler.Add(FrameProfiler::Phase::Place, microseconds(frame * 500));
+        profiler.EndFrame();
+    }
+
+    auto stats = profiler.GetStats(FrameProfiler::Phase::Place);
+    ASSERT_EQ(2, stats.mCalls);
+    ASSERT_NEAR(1, stats.mMin, 0.0001);
+    ASSERT_NEAR(50, stats.mMedian, 0.0001);
+    ASSERT_NEAR(99, stats.mP99, 0.0001);
+
+    // Other phases saw nothing
+    ASSERT_EQ(0, profiler.GetStats(FrameProfiler::Phase::Keyframe).mCalls);
+
+    // Only the most recent frames are kept
+    profiler.SetWindow(10);
+    ASSERT_EQ(10u, profiler.GetFrameCount());
+    ASSERT_NEAR(91, profiler.GetStats(FrameProfiler::Phase::Place).mMin, 0.0001);
+
+    // A scope adds a call to its phase
+    {
+        FrameProfiler::Scope scope(FrameProfiler::Phase::Keyframe);
+    }
+    profiler.EndFrame();
+    ASSERT_EQ(1, profiler.GetStats(FrameProfiler::Phase::Keyframe).mCalls);
+
+    profiler.SetEnabled(false);
+    profiler.SetWindow(FrameProfiler::DefaultWindow);
+    profiler.Reset();
+}
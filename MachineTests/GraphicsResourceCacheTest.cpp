@@ -0,0 +1,111 @@
+/**
+ * @file GraphicsResourceCacheTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <GraphicsResourceCache.h>
+
+/**
+ * Create a graphics context that draws on an image
+ * @param surface Image to draw on
+ * @return Graphics context
+ */
+static std::shared_ptr<wxGraphicsContext> CreateGraphics(wxImage& surface)
+{
+    return std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(surface));
+}
+
+TEST(GraphicsResourceCacheTest, Bitmaps)
+{
+    wxImage surface(64, 64);
+    auto graphics = CreateGraphics(surface);
+
+    auto& cache = GraphicsResourceCache::Get();
+    cache.Clear();
+
+    auto image = std::make_shared<const wxImage>(16, 16);
+
+    // The first request creates the bitmap, later ones reuse it
+    cache.GetBitmap(graphics, image);
+    ASSERT_EQ(0, cache.GetHits());
+    ASSERT_EQ(1, cache.GetMisses());
+
+    for (int i = 0; i < 10; i++)
+    {
+        cache.GetBitmap(graphics, image);
+    }
+
+    ASSERT_EQ(10, cache.GetHits());
+    ASSERT_EQ(1, cache.GetMisses());
+    ASSERT_EQ(1, cache.GetCount());
+
+    // Another variant of the same image is a different bitmap
+    int created = 0;
+    auto create = [&graphics, &image, &created]() {
+        created++;
+        return graphics->CreateBitmapFromImage(*image);
+    };
+
+    cache.GetBitmap(graphics, image, 1, create);
+    cache.GetBitmap(graphics, image, 1, create);
+    ASSERT_EQ(1, created);
+    ASSERT_EQ(2, cache.GetCount());
+
+    // Invalidating a variant leaves the others alone
+    cache.Invalidate(image.get(), 1);
+    ASSERT_EQ(1, cache.GetCount());
+    cache.GetBitmap(graphics, image, 1, create);
+    ASSERT_EQ(2, created);
+
+    cache.Invalidate(image.get());
+    ASSERT_EQ(0, cache.GetCount());
+
+    cache.Clear();
+}
+
+TEST(GraphicsResourceCacheTest, Released)
+{
+    wxImage surface(64, 64);
+    auto graphics = CreateGraphics(surface);
+
+    auto& cache = GraphicsResourceCache::Get();
+    cache.Clear();
+
+    auto image = std::make_shared<const wxImage>(16, 16);
+    auto points = std::make_shared<const int>(0);
+    cache.GetBitmap(graphics, image);
+    cache.GetPath(graphics, points, [&graphics]() { return graphics->CreatePath(); });
+    ASSERT_EQ(2, cache.GetCount());
+
+    // Resources of objects that are gone are released by a purge
+    image.reset();
+    cache.Purge();
+    ASSERT_EQ(1, cache.GetCount());
+
+    cache.GetPath(graphics, points, [&graphics]() { return graphics->CreatePath(); });
+    ASSERT_EQ(1, cache.GetHits());
+
+    cache.Clear();
+}
+
+TEST(GraphicsResourceCacheTest, Brushes)
+{
+    wxImage surface(64, 64);
+    auto graphics = CreateGraphics(surface);
+
+    auto& cache = GraphicsResourceCache::Get();
+    cache.Clear();
+
+    cache.GetBrush(graphics, wxColour(255, 0, 0));
+    cache.GetBrush(graphics, wxColour(255, 0, 0));
+    cache.GetBrush(graphics, wxColour(0, 255, 0));
+    ASSERT_EQ(1, cache.GetHits());
+    ASSERT_EQ(2, cache.GetMisses());
+    ASSERT_EQ(2, cache.GetCount());
+
+    cache.Clear();
+}
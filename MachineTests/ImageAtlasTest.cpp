@@ -0,0 +1,131 @@
+/**
+ * @file ImageAtlasTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <ImageAtlas.h>
+
+/**
+ * Make an image where every pixel is different
+ * @param width Image width
+ * @param height Image height
+ * @param seed Value that makes this image different from others
+ * @return Image with an alpha channel
+ */
+static std::shared_ptr<const wxImage> MakeImage(int width, int height, int seed)
+{
+    auto image = std::make_shared<wxImage>(width, height);
+    image->InitAlpha();
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            image->SetRGB(x, y, (unsigned char)(x + seed), (unsigned char)y, (unsigned char)seed);
+            image->SetAlpha(x, y, (unsigned char)(x * y + seed));
+        }
+    }
+
+    return image;
+}
+
+/**
+ * Determine if a page holds an image exactly
+ * @param page Atlas page
+ * @param rect Rectangle the image is in on the page
+ * @param image The image
+ * @return true if every pixel matches
+ */
+static bool Matches(const wxImage& page, wxRect rect, const wxImage& image)
+{
+    for (int y = 0; y < rect.height; y++)
+    {
+        for (int x = 0; x < rect.width; x++)
+        {
+            int px = rect.x + x;
+            int py = rect.y + y;
+            if (page.GetRed(px, py) != image.GetRed(x, y) ||
+                    page.GetGreen(px, py) != image.GetGreen(x, y) ||
+                    page.GetBlue(px, py) != image.GetBlue(x, y) ||
+                    page.GetAlpha(px, py) != image.GetAlpha(x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+TEST(ImageAtlasTest, Pack)
+{
+    std::vector<std::pair<std::wstring, std::shared_ptr<const wxImage>>> images;
+    images.emplace_back(L"base", MakeImage(512, 47, 1));
+    images.emplace_back(L"post", MakeImage(20, 300, 2));
+    images.emplace_back(L"platform", MakeImage(594, 65, 3));
+    images.emplace_back(L"pulley", MakeImage(256, 256, 4));
+    images.emplace_back(L"bubble", MakeImage(20, 20, 5));
+    images.emplace_back(L"huge", MakeImage(ImageAtlas::PageSize, 10, 6));
+
+    ImageAtlas atlas;
+    atlas.Build(images);
+    ASSERT_EQ(1, atlas.GetNumPages());
+
+    // Too big for a page
+    ASSERT_EQ(nullptr, atlas.Find(L"huge"));
+    ASSERT_EQ(nullptr, atlas.Find(L"missing"));
+
+    std::vector<wxRect> padded;
+    for (int i = 0; i < 5; i++)
+    {
+        auto region = atlas.Find(images[i].first);
+        ASSERT_NE(nullptr, region);
+        ASSERT_EQ(images[i].second->GetWidth(), region->mRect.width);
+        ASSERT_EQ(images[i].second->GetHeight(), region->mRect.height);
+        ASSERT_TRUE(Matches(*atlas.GetPage(region->mPage), region->mRect, *images[i].second));
+
+        // Nothing overlaps, including the padding
+        auto rect = region->mRect;
+        rect.Inflate(ImageAtlas::Padding);
+        ASSERT_TRUE(rect.x >= 0 && rect.y >= 0);
+        ASSERT_TRUE(rect.GetRight() < ImageAtlas::PageSize);
+        ASSERT_TRUE(rect.GetBottom() < atlas.GetPage(region->mPage)->GetHeight());
+        for (auto& other : padded)
+        {
+            ASSERT_FALSE(rect.Intersects(other));
+        }
+
+        padded.push_back(rect);
+    }
+
+    // The padding repeats the edge of the image
+    auto region = atlas.Find(L"post");
+    auto& page = *atlas.GetPage(region->mPage);
+    auto& post = *images[1].second;
+    ASSERT_EQ(post.GetRed(0, 0), page.GetRed(region->mRect.x - 1, region->mRect.y - 1));
+    ASSERT_EQ(post.GetAlpha(19, 299), page.GetAlpha(region->mRect.x + 20, region->mRect.y + 300));
+}
+
+TEST(ImageAtlasTest, Pages)
+{
+    // Four of these can not fit on one page
+    std::vector<std::pair<std::wstring, std::shared_ptr<const wxImage>>> images;
+    for (int i = 0; i < 4; i++)
+    {
+        images.emplace_back(std::to_wstring(i), MakeImage(600, 400, i));
+    }
+
+    ImageAtlas atlas;
+    atlas.Build(images);
+    ASSERT_EQ(2, atlas.GetNumPages());
+
+    for (auto& image : images)
+    {
+        auto region = atlas.Find(image.first);
+        ASSERT_NE(nullptr, region);
+        ASSERT_TRUE(Matches(*atlas.GetPage(region->mPage), region->mRect, *image.second));
+    }
+}
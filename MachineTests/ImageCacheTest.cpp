@@ -0,0 +1,74 @@
+/**
+ * @file ImageCacheTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <ImageCache.h>
+
+TEST(ImageCacheTest, Shared)
+{
+    auto& cache = ImageCache::Get();
+    cache.Clear();
+
+    auto image1 = cache.GetImage(L"images/bubble.png");
+    ASSERT_NE(nullptr, image1);
+    ASSERT_TRUE(image1->IsOk());
+
+    // A different spelling of the same file is the same image
+    auto image2 = cache.GetImage(L"images/../images/bubble.png");
+    ASSERT_EQ(image1.get(), image2.get());
+    ASSERT_EQ(1u, cache.GetCount());
+    ASSERT_EQ(1u, cache.GetMisses());
+    ASSERT_EQ(1u, cache.GetHits());
+
+    ASSERT_EQ(nullptr, cache.GetImage(L"images/no-such-image.png"));
+    ASSERT_EQ(1u, cache.GetCount());
+}
+
+TEST(ImageCacheTest, Budget)
+{
+    auto& cache = ImageCache::Get();
+    cache.Clear();
+
+    auto held = cache.GetImage(L"images/flag.png");
+    cache.GetImage(L"images/post.png");
+    ASSERT_EQ(2u, cache.GetCount());
+
+    // Only the image nobody holds is released
+    cache.SetBudget(1);
+    ASSERT_EQ(1u, cache.GetCount());
+    ASSERT_EQ(held.get(), cache.GetImage(L"images/flag.png").get());
+
+    // Released images are loaded again when asked for
+    held = nullptr;
+    cache.SetBudget(ImageCache::DefaultBudget);
+    auto post = cache.GetImage(L"images/post.png");
+    ASSERT_NE(nullptr, post);
+    ASSERT_EQ(2u, cache.GetCount());
+}
+
+TEST(ImageCacheTest, Atlas)
+{
+    auto& cache = ImageCache::Get();
+    cache.Clear();
+
+    cache.LoadAtlas(L"images", {L"post.png", L"flag.png", L"no-such-image.png"});
+
+    std::shared_ptr<const wxImage> page;
+    wxRect rect;
+    auto post = cache.GetImage(L"images/post.png");
+    ASSERT_TRUE(cache.FindInAtlas(post, page, rect));
+    ASSERT_EQ(post->GetWidth(), rect.width);
+    ASSERT_EQ(post->GetHeight(), rect.height);
+
+    // Only the named images are in the atlas
+    auto base = cache.GetImage(L"images/base.png");
+    ASSERT_NE(nullptr, base);
+    ASSERT_FALSE(cache.FindInAtlas(base, page, rect));
+
+    cache.Clear();
+}
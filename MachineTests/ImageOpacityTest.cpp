@@ -0,0 +1,65 @@
+/**
+ * @file ImageOpacityTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <ImageOpacity.h>
+
+TEST(ImageOpacityTest, Quantize)
+{
+    ASSERT_EQ(0, ImageOpacity::Quantize(0));
+    ASSERT_EQ(ImageOpacity::Levels, ImageOpacity::Quantize(1));
+    ASSERT_EQ(ImageOpacity::Levels / 2, ImageOpacity::Quantize(0.5));
+
+    // Nearly opaque rounds to opaque, nearly transparent to transparent
+    ASSERT_EQ(ImageOpacity::Levels, ImageOpacity::Quantize(0.99));
+    ASSERT_EQ(0, ImageOpacity::Quantize(0.01));
+}
+
+TEST(ImageOpacityTest, ScaleAlpha)
+{
+    std::vector<unsigned char> alpha(1000);
+    for (size_t i = 0; i < alpha.size(); i++)
+    {
+        alpha[i] = (unsigned char)i;
+    }
+
+    for (int scale = 0; scale <= 255; scale++)
+    {
+        auto scaled = alpha;
+        ImageOpacity::ScaleAlpha(scaled.data(), scaled.size(), scale);
+        for (size_t i = 0; i < alpha.size(); i++)
+        {
+            ASSERT_EQ(int(alpha[i] * scale / 255.0 + 0.5), scaled[i]);
+        }
+    }
+}
+
+TEST(ImageOpacityTest, Create)
+{
+    wxImage image(4, 4);
+    image.InitAlpha();
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            image.SetRGB(x, y, 10, 20, 30);
+            image.SetAlpha(x, y, 200);
+        }
+    }
+
+    auto faded = ImageOpacity::Create(image, ImageOpacity::Levels / 2);
+    ASSERT_EQ(10, faded.GetRed(1, 2));
+    ASSERT_EQ(100, faded.GetAlpha(1, 2));
+
+    // The original is not changed
+    ASSERT_EQ(200, image.GetAlpha(1, 2));
+
+    // Images without alpha are treated as opaque
+    wxImage opaque(4, 4);
+    ASSERT_EQ(128, ImageOpacity::Create(opaque, ImageOpacity::Levels / 2).GetAlpha(0, 0));
+}
@@ -9,6 +9,10 @@
 
 #include <MachineSystemFactory.h>
 #include <IMachineSystem.h>
+#include <Machine.h>
+#include <Shape.h>
+
+using namespace std;
 
 TEST(MachineTest, Constructor)
 {
@@ -62,4 +66,143 @@ TEST(MachineTest, MachineNumber)
     // Ensure we can go back to machine number 1
     machine->ChooseMachine(1);
     ASSERT_EQ(1, machine->GetMachineNumber());
-}
\ No newline at end of file
+}
+
+/**
+ * Create a shape that is one square
+ * @param position Shape position
+ * @param color Square color
+ * @return Shape
+ */
+static shared_ptr<Shape> MakeSquare(wxPoint position, wxColour color)
+{
+    auto square = make_shared<Shape>();
+    square->Rectangle(0, 60, 60, 60);
+    square->SetColor(color);
+    square->SetPosition(position);
+    return square;
+}
+
+/**
+ * Create a machine of three overlapping squares
+ * @param withStatic Make the first two squares static?
+ * @return Machine
+ */
+static shared_ptr<Machine> MakeSquares(bool withStatic)
+{
+    auto machine = make_shared<Machine>(1);
+
+    auto red = MakeSquare(wxPoint(0, 0), *wxRED);
+    auto blue = MakeSquare(wxPoint(30, 30), *wxBLUE);
+    red->SetStatic(withStatic);
+    blue->SetStatic(withStatic);
+
+    machine->AddComponent(red);
+    machine->AddComponent(blue);
+    machine->AddComponent(MakeSquare(wxPoint(60, 60), *wxGREEN));
+    return machine;
+}
+
+/**
+ * Draw a machine into an image
+ * @param machine Machine to draw
+ * @param scale Scale to draw at
+ * @return 200 by 200 image with the machine at 20, 20
+ */
+static wxImage DrawMachine(Machine& machine, double scale = 1)
+{
+    wxImage image(200, 200);
+
+    {
+        // The image is complete once the context is gone
+        auto graphics = shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+        graphics->Scale(scale, scale);
+        machine.Draw(graphics, wxPoint(20, 20));
+    }
+
+    return image;
+}
+
+/**
+ * Determine if two images have the same pixels, allowing
+ * for rounding where edges are blended
+ * @param a First image
+ * @param b Second image
+ * @return true if every pixel is within a couple of levels
+ */
+static bool SamePixels(const wxImage& a, const wxImage& b)
+{
+    for (int y = 0; y < a.GetHeight(); y++)
+    {
+        for (int x = 0; x < a.GetWidth(); x++)
+        {
+            if (abs(a.GetRed(x, y) - b.GetRed(x, y)) > 2 ||
+                    abs(a.GetGreen(x, y) - b.GetGreen(x, y)) > 2 ||
+                    abs(a.GetBlue(x, y) - b.GetBlue(x, y)) > 2)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+TEST(MachineTest, StaticLayer)
+{
+    auto withLayer = MakeSquares(true);
+    auto without = MakeSquares(false);
+
+    // The static squares drawn from the layer look the same
+    auto image = DrawMachine(*withLayer);
+    ASSERT_TRUE(SamePixels(DrawMachine(*without), image));
+    ASSERT_EQ(1, withLayer->GetStaticLayerDraws());
+    ASSERT_EQ(0, without->GetStaticLayerDraws());
+    ASSERT_EQ(255, image.GetRed(30, 30));
+    ASSERT_EQ(255, image.GetBlue(70, 70));
+    ASSERT_EQ(255, image.GetGreen(100, 100));
+
+    // Later frames reuse the layer
+    withLayer->SetTime(1);
+    DrawMachine(*withLayer);
+    ASSERT_EQ(1, withLayer->GetStaticLayerDraws());
+
+    withLayer->InvalidateStaticLayer();
+    DrawMachine(*withLayer);
+    ASSERT_EQ(2, withLayer->GetStaticLayerDraws());
+
+    withLayer->AddComponent(MakeSquare(wxPoint(0, 0), *wxBLACK));
+    DrawMachine(*withLayer);
+    ASSERT_EQ(3, withLayer->GetStaticLayerDraws());
+
+    // A new scale draws the layer at that scale
+    image = DrawMachine(*withLayer, 2);
+    ASSERT_EQ(4, withLayer->GetStaticLayerDraws());
+    ASSERT_TRUE(SamePixels(DrawMachine(*without, 2), image));
+}
+
+TEST(MachineTest, StaticComponentChanges)
+{
+    auto machine = MakeSquares(true);
+    auto red = machine->GetComponents()[0];
+    DrawMachine(*machine);
+
+    // Moving a static component draws the layer again
+    red->SetPosition(wxPoint(100, 0));
+    auto image = DrawMachine(*machine);
+    ASSERT_EQ(2, machine->GetStaticLayerDraws());
+    ASSERT_EQ(255, image.GetRed(130, 30));
+    ASSERT_EQ(0, image.GetRed(30, 30));
+
+    // So does recolouring one
+    dynamic_pointer_cast<Shape>(red)->SetColor(*wxGREEN);
+    image = DrawMachine(*machine);
+    ASSERT_EQ(3, machine->GetStaticLayerDraws());
+    ASSERT_EQ(255, image.GetGreen(130, 30));
+
+    // Once the bottom square is not static, no
+    // squares come from the layer
+    red->SetStatic(false);
+    DrawMachine(*machine);
+    ASSERT_EQ(3, machine->GetStaticLayerDraws());
+}
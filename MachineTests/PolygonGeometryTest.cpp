@@ -0,0 +1,64 @@
+/**
+ * @file PolygonGeometryTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <PolygonGeometry.h>
+
+using namespace cse335;
+
+/**
+ * Make the points of a rectangle
+ * @param width Rectangle width
+ * @param height Rectangle height
+ * @return Points
+ */
+static std::vector<wxPoint2DDouble> RectanglePoints(double width, double height)
+{
+    return {wxPoint2DDouble(0, 0), wxPoint2DDouble(0, -height),
+            wxPoint2DDouble(width, -height), wxPoint2DDouble(width, 0)};
+}
+
+TEST(PolygonGeometryTest, Shared)
+{
+    auto count = PolygonGeometry::GetSharedCount();
+
+    auto geometry1 = PolygonGeometry::Create(RectanglePoints(20, 100), false);
+    auto geometry2 = PolygonGeometry::Create(RectanglePoints(20, 100), false);
+    ASSERT_EQ(geometry1.get(), geometry2.get());
+    ASSERT_EQ(count + 1, PolygonGeometry::GetSharedCount());
+
+    // Different points, or the same points as a circle, are not shared
+    auto geometry3 = PolygonGeometry::Create(RectanglePoints(20, 101), false);
+    auto geometry4 = PolygonGeometry::Create(RectanglePoints(20, 100), true);
+    ASSERT_NE(geometry1.get(), geometry3.get());
+    ASSERT_NE(geometry1.get(), geometry4.get());
+    ASSERT_EQ(count + 3, PolygonGeometry::GetSharedCount());
+
+    // Geometries are released with the last polygon that uses them
+    geometry1 = nullptr;
+    ASSERT_EQ(count + 3, PolygonGeometry::GetSharedCount());
+    geometry2 = nullptr;
+    ASSERT_EQ(count + 2, PolygonGeometry::GetSharedCount());
+
+    // And created again when needed
+    geometry1 = PolygonGeometry::Create(RectanglePoints(20, 100), false);
+    ASSERT_EQ(4u, geometry1->GetPoints().size());
+    ASSERT_EQ(count + 3, PolygonGeometry::GetSharedCount());
+}
+
+TEST(PolygonGeometryTest, Bounds)
+{
+    auto geometry = PolygonGeometry::Create(RectanglePoints(20, 100), false);
+
+    ASSERT_DOUBLE_EQ(0, geometry->GetTopLeft().m_x);
+    ASSERT_DOUBLE_EQ(-100, geometry->GetTopLeft().m_y);
+    ASSERT_DOUBLE_EQ(20, geometry->GetSize().m_x);
+    ASSERT_DOUBLE_EQ(100, geometry->GetSize().m_y);
+    ASSERT_DOUBLE_EQ(10, geometry->GetCenter().m_x);
+    ASSERT_DOUBLE_EQ(-50, geometry->GetCenter().m_y);
+}
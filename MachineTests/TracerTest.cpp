@@ -0,0 +1,73 @@
+/**
+ * @file TracerTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <Tracer.h>
+#include <sstream>
+#include <thread>
+
+TEST(TracerTest, Disabled)
+{
+    auto& tracer = Tracer::Get();
+    tracer.SetEnabled(false);
+    tracer.Clear();
+
+    {
+        Tracer::Scope trace("Ignored");
+    }
+
+    ASSERT_EQ(0u, tracer.GetEventCount());
+}
+
+TEST(TracerTest, Write)
+{
+    auto& tracer = Tracer::Get();
+    tracer.Clear();
+    tracer.SetEnabled(true);
+
+    {
+        Tracer::Scope trace("Main", "frame", 42);
+    }
+
+    // Another thread gets its own buffer
+    std::thread worker([]() {
+        Tracer::Scope trace("Worker");
+    });
+    worker.join();
+
+    tracer.SetEnabled(false);
+    ASSERT_EQ(2u, tracer.GetEventCount());
+
+    std::ostringstream stream;
+    tracer.Write(stream);
+    auto json = stream.str();
+
+    ASSERT_EQ(0u, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    ASSERT_NE(std::string::npos, json.find("{\"name\":\"Main\",\"ph\":\"X\""));
+    ASSERT_NE(std::string::npos, json.find("\"args\":{\"frame\":42}"));
+    ASSERT_NE(std::string::npos, json.find("{\"name\":\"Worker\",\"ph\":\"X\""));
+
+    tracer.Clear();
+}
+
+TEST(TracerTest, Ring)
+{
+    auto& tracer = Tracer::Get();
+    tracer.Clear();
+    tracer.SetEnabled(true);
+
+    // Only the most recent events are kept
+    for (size_t i = 0; i < Tracer::BufferSize + 10; i++)
+    {
+        Tracer::Scope trace("Event");
+    }
+
+    tracer.SetEnabled(false);
+    ASSERT_EQ(Tracer::BufferSize, tracer.GetEventCount());
+    tracer.Clear();
+}
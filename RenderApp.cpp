@@ -0,0 +1,164 @@
+/**
+ * @file RenderApp.cpp
+ * @author Aditya Menon
+ */
+
+#include "pch.h"
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/xml/xml.h>
+#include <wx/graphics.h>
+#include <thread>
+#include <algorithm>
+
+#include "RenderApp.h"
+#include <Picture.h>
+#include <PictureFactory.h>
+#include <FrameExporter.h>
+#include <tracer.h>
+
+/// Command line options
+static const wxCmdLineEntryDesc CommandLineOptions[] =
+{
+    { wxCMD_LINE_SWITCH, "h", "help", "show this help", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "o", "output", "directory to write frames to", wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "r", "resources", "program resources directory", wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "f", "first", "first frame to render", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "l", "last", "last frame to render", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "j", "threads", "number of render threads, 0 for one per core", wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "t", "trace", "write a Chrome trace of the export to this file", wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_SWITCH, nullptr, "raw", "write raw RGBA frames instead of PNG" },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, "animation file", wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_NONE }
+};
+
+/**
+ * Initialize the application.
+ * @return True if successful
+ */
+bool RenderApp::OnInit()
+{
+    if (!wxAppConsole::OnInit())
+        return false;
+
+    // Add image type handlers
+    wxInitAllImageHandlers();
+
+    return true;
+}
+
+/**
+ * Describe the command line options
+ * @param parser Command line parser
+ */
+void RenderApp::OnInitCmdLine(wxCmdLineParser& parser)
+{
+    parser.SetDesc(CommandLineOptions);
+    parser.SetSwitchChars("-");
+}
+
+/**
+ * Handle the parsed command line
+ * @param parser Command line parser
+ * @return True if the command line is usable
+ */
+bool RenderApp::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+    mAnimFile = parser.GetParam(0);
+    parser.Found("o", &mOutputDir);
+    parser.Found("f", &mFirstFrame);
+    parser.Found("l", &mLastFrame);
+    parser.Found("j", &mThreads);
+    parser.Found("t", &mTraceFile);
+    mRaw = parser.Found("raw");
+
+    // Resources are copied next to the executable by the build
+    if (!parser.Found("r", &mResourcesDir))
+    {
+        mResourcesDir = wxFileName(wxStandardPaths::Get().GetExecutablePath()).GetPath();
+    }
+
+    return true;
+}
+
+/**
+ * Render the animation
+ * @return Exit code, 0 if successful
+ */
+int RenderApp::OnRun()
+{
+    if (!wxFileName::FileExists(mAnimFile))
+    {
+        wxPrintf("Unable to open animation file %s\n", mAnimFile);
+        return 1;
+    }
+
+    if (!wxFileName::DirExists(mOutputDir) && !wxFileName::Mkdir(mOutputDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+    {
+        wxPrintf("Unable to create output directory %s\n", mOutputDir);
+        return 1;
+    }
+
+    // Each render thread gets its own copy of the picture
+    auto resourcesDir = mResourcesDir.ToStdWstring();
+    auto animFile = mAnimFile;
+    auto createPicture = [resourcesDir, animFile]() {
+        PictureFactory factory;
+        auto picture = factory.Create(resourcesDir);
+        picture->Load(animFile);
+        return picture;
+    };
+
+    // The first picture checks the file loads, so the
+    // render threads can rely on it loading for them
+    PictureFactory factory;
+    auto picture = factory.Create(resourcesDir);
+    if (!picture->Load(animFile))
+    {
+        wxPrintf("Unable to read animation file %s\n", mAnimFile);
+        return 1;
+    }
+
+    int threads = int(mThreads);
+    if (threads <= 0)
+    {
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+
+    FrameExporter exporter(picture);
+    exporter.SetOutputDir(mOutputDir.ToStdWstring());
+    exporter.SetFormat(mRaw ? FrameExporter::Format::RGBA : FrameExporter::Format::PNG);
+    exporter.SetFrameRange(mFirstFrame, mLastFrame);
+    exporter.SetThreads(threads);
+    exporter.SetPictureFactory(createPicture);
+
+    auto& tracer = Tracer::Get();
+    tracer.SetEnabled(!mTraceFile.IsEmpty());
+
+    bool ok = exporter.Export();
+
+    if (tracer.IsEnabled())
+    {
+        tracer.SetEnabled(false);
+        if (!tracer.Write(mTraceFile.ToStdWstring()))
+        {
+            wxPrintf("Unable to write %s\n", mTraceFile);
+        }
+    }
+
+    auto size = picture->GetSize();
+    int frames = exporter.GetFramesWritten();
+    double elapsed = exporter.GetElapsed();
+    wxPrintf("Rendered %d frames of %dx%d on %d threads in %.2f seconds (%.1f fps)\n",
+            frames, size.GetWidth(), size.GetHeight(), threads, elapsed, elapsed > 0 ? frames / elapsed : 0.0);
+
+    if (!ok)
+    {
+        wxPrintf("Unable to write %s\n", exporter.GetFrameFilename(exporter.GetFirstFrame() + frames));
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file RenderApp.h
+ * @author Aditya Menon
+ *
+ * Command-line application that renders an animation to image files
+ */
+
+#ifndef CANADIANEXPERIENCE_RENDERAPP_H
+#define CANADIANEXPERIENCE_RENDERAPP_H
+
+/**
+ * Command-line application that renders an animation to image files.
+ *
+ * Usage: CanadianExperienceRender [options] file.anim
+ *
+ * No windows are created, so this runs on machines with no display.
+ */
+class RenderApp : public wxAppConsole {
+private:
+    /// Animation file to render
+    wxString mAnimFile;
+
+    /// Directory to write frames to
+    wxString mOutputDir = L".";
+
+    /// Directory that contains the program resources
+    wxString mResourcesDir;
+
+    /// Write raw RGBA instead of PNG
+    bool mRaw = false;
+
+    /// First frame to render
+    long mFirstFrame = 0;
+
+    /// Last frame to render, or -1 for the end of the animation
+    long mLastFrame = -1;
+
+    /// Number of render threads, 0 for one per core
+    long mThreads = 1;
+
+    /// File to write a Chrome trace of the export to, empty for none
+    wxString mTraceFile;
+
+public:
+    bool OnInit() override;
+    void OnInitCmdLine(wxCmdLineParser& parser) override;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) override;
+    int OnRun() override;
+};
+
+#endif //CANADIANEXPERIENCE_RENDERAPP_H
@@ -0,0 +1,187 @@
+/**
+ * @file AnimBinaryTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <fstream>
+
+#include <Timeline.h>
+#include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
+#include <AnimBinary.h>
+#include <AnimBinaryWriter.h>
+#include <AnimConverter.h>
+
+/**
+ * Set a keyframe on an angle and a point channel at a frame
+ * @param timeline Timeline the channels are on
+ * @param frame Frame to set the keyframes at
+ * @param angleChannel Angle channel
+ * @param angle Angle to set
+ * @param pointChannel Point channel
+ * @param point Point to set
+ */
+static void SetKeyframes(Timeline& timeline, int frame, AnimChannelAngle& angleChannel, double angle,
+        AnimChannelPoint& pointChannel, wxPoint point)
+{
+    timeline.SetCurrentTime((frame + 0.5) / timeline.GetFrameRate());
+    angleChannel.SetKeyframe(angle);
+    pointChannel.SetKeyframe(point);
+}
+
+TEST(AnimBinaryTest, RoundTrip)
+{
+    Timeline timeline;
+    timeline.SetNumFrames(123);
+    timeline.SetFrameRate(24);
+
+    AnimChannelAngle angleChannel;
+    angleChannel.SetName(L"Harold:arm");
+    timeline.AddChannel(&angleChannel);
+
+    AnimChannelPoint pointChannel;
+    pointChannel.SetName(L"Harold:position");
+    timeline.AddChannel(&pointChannel);
+
+    AnimChannelAngle emptyChannel;
+    emptyChannel.SetName(L"Harold:leg");
+    timeline.AddChannel(&emptyChannel);
+
+    // An angle the XML format would round
+    double angle = 0.1234567890123;
+    SetKeyframes(timeline, 12, angleChannel, angle, pointChannel, wxPoint(-5, 7));
+    SetKeyframes(timeline, 48, angleChannel, -1.5, pointChannel, wxPoint(100, 200));
+
+    auto filename = wxFileName::CreateTempFileName(L"anim").ToStdWstring();
+    AnimBinaryWriter writer;
+    timeline.Save(writer);
+    writer.AddMachine(L"Machine 1", wxPoint(400, 500), 2, 30, 0.75);
+    ASSERT_TRUE(writer.Write(filename));
+    ASSERT_TRUE(AnimBinary::IsBinary(filename));
+
+    AnimBinary file;
+    ASSERT_TRUE(file.Open(filename));
+    ASSERT_EQ(123, file.GetNumFrames());
+    ASSERT_EQ(24, file.GetFrameRate());
+    ASSERT_EQ(3, file.GetNumChannels());
+    ASSERT_EQ(1, file.GetNumMachines());
+    ASSERT_EQ(std::wstring(L"Machine 1"), file.GetMachineName(0));
+    ASSERT_EQ(2, file.GetMachine(0).mMachineNumber);
+    ASSERT_EQ(0.75, file.GetMachine(0).mScale);
+
+    // Load into a different timeline, which has the
+    // channels in a different order
+    Timeline loaded;
+    AnimChannelPoint loadedPoint;
+    loadedPoint.SetName(L"Harold:position");
+    loaded.AddChannel(&loadedPoint);
+
+    AnimChannelAngle loadedAngle;
+    loadedAngle.SetName(L"Harold:arm");
+    loaded.AddChannel(&loadedAngle);
+
+    loaded.Load(file);
+    ASSERT_EQ(123, loaded.GetNumFrames());
+    ASSERT_EQ(24, loaded.GetFrameRate());
+
+    ASSERT_EQ(angleChannel.GetKeyframeFrames(), loadedAngle.GetKeyframeFrames());
+    ASSERT_EQ(angleChannel.GetKeyframeAngles(), loadedAngle.GetKeyframeAngles());
+    ASSERT_EQ(pointChannel.GetKeyframeFrames(), loadedPoint.GetKeyframeFrames());
+    ASSERT_EQ(pointChannel.GetKeyframePoints(), loadedPoint.GetKeyframePoints());
+
+    // The values are exact, not rounded through text
+    loaded.SetCurrentTime(12.0 / 24);
+    ASSERT_EQ(angle, loadedAngle.GetAngle());
+    ASSERT_EQ(wxPoint(-5, 7), loadedPoint.GetPoint());
+
+    // And the loaded channels tween and accept new keyframes
+    loaded.SetCurrentTime(30.0 / 24);
+    ASSERT_EQ(wxPoint(47, 103), loadedPoint.GetPoint());
+    loadedAngle.SetKeyframe(1);
+    ASSERT_EQ(std::vector<int>({12, 30, 48}), loadedAngle.GetKeyframeFrames());
+
+    wxRemoveFile(filename);
+}
+
+TEST(AnimBinaryTest, Invalid)
+{
+    auto filename = wxFileName::CreateTempFileName(L"anim").ToStdWstring();
+
+    {
+        std::ofstream out(wxString(filename).fn_str(), std::ios::binary);
+        out << "<?xml version=\"1.0\"?><anim/>";
+    }
+
+    AnimBinary file;
+    ASSERT_FALSE(AnimBinary::IsBinary(filename));
+    ASSERT_FALSE(file.Open(filename));
+
+    // The right magic, but truncated
+    {
+        std::ofstream out(wxString(filename).fn_str(), std::ios::binary);
+        out.write(AnimBinary::GetMagic(), 8);
+        out << "truncated";
+    }
+
+    ASSERT_TRUE(AnimBinary::IsBinary(filename));
+    ASSERT_FALSE(file.Open(filename));
+
+    wxRemoveFile(filename);
+}
+
+TEST(AnimBinaryTest, Convert)
+{
+    auto xmlFile = wxFileName::CreateTempFileName(L"anim").ToStdWstring();
+    auto binaryFile = wxFileName::CreateTempFileName(L"anim").ToStdWstring();
+    auto xmlFile2 = wxFileName::CreateTempFileName(L"anim").ToStdWstring();
+
+    {
+        std::ofstream out(wxString(xmlFile).fn_str(), std::ios::binary);
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<anim title=\"Canadian Experience\" numframes=\"300\" framerate=\"30\">"
+               "<channel name=\"arm\"><keyframe frame=\"20\" angle=\"0.500000\"/>"
+               "<keyframe frame=\"5\" angle=\"0.250000\"/></channel>"
+               "<channel name=\"position\"><keyframe frame=\"0\" x=\"1\" y=\"2\"/></channel>"
+               "<machines><machine type=\"machine\" name=\"Machine 2\" machine-number=\"1\" "
+               "start-frame=\"60\" scale=\"0.50\"><position x=\"1100\" y=\"500\"/></machine></machines>"
+               "</anim>";
+    }
+
+    ASSERT_TRUE(AnimConverter::XmlToBinary(xmlFile, binaryFile));
+
+    AnimBinary file;
+    ASSERT_TRUE(file.Open(binaryFile));
+    ASSERT_EQ(300, file.GetNumFrames());
+    ASSERT_EQ(2, file.GetNumChannels());
+
+    // Keyframes out of order in the XML are sorted
+    ASSERT_EQ(AnimBinary::ChannelType::Angle, file.GetChannelType(0));
+    ASSERT_EQ(2, file.GetNumKeyframes(0));
+    ASSERT_EQ(5, file.GetFrames(0)[0]);
+    ASSERT_EQ(0.25, file.GetAngles(0)[0]);
+
+    ASSERT_EQ(AnimBinary::ChannelType::Point, file.GetChannelType(1));
+    ASSERT_EQ(2, file.GetPoints(1)[1]);
+
+    ASSERT_EQ(1, file.GetNumMachines());
+    ASSERT_EQ(1100, file.GetMachine(0).mX);
+    ASSERT_EQ(60, file.GetMachine(0).mStartFrame);
+
+    // And back to XML
+    ASSERT_TRUE(AnimConverter::BinaryToXml(binaryFile, xmlFile2));
+    ASSERT_FALSE(AnimBinary::IsBinary(xmlFile2));
+
+    wxXmlDocument document;
+    ASSERT_TRUE(document.Load(xmlFile2));
+    auto channel = document.GetRoot()->GetChildren();
+    ASSERT_EQ(L"arm", channel->GetAttribute(L"name"));
+    ASSERT_EQ(L"5", channel->GetChildren()->GetAttribute(L"frame"));
+
+    wxRemoveFile(xmlFile);
+    wxRemoveFile(binaryFile);
+    wxRemoveFile(xmlFile2);
+}
@@ -8,10 +8,82 @@
 #include "gtest/gtest.h"
 
 #include <AnimChannelAngle.h>
+#include <Timeline.h>
 
 TEST(AnimChannelAngleTest, Name)
 {
     AnimChannelAngle channel;
     channel.SetName(L"abcdexx");
     ASSERT_EQ(std::wstring(L"abcdexx"), channel.GetName());
-}
\ No newline at end of file
+}
+
+TEST(AnimChannelAngleTest, Seek)
+{
+    Timeline timeline;
+    timeline.SetNumFrames(4000);
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    // A keyframe every 3 frames with an angle that
+    // is the frame number, so tweening gives the frame.
+    // The half frame keeps the time from rounding down.
+    for (int frame = 0; frame < 3000; frame += 3)
+    {
+        timeline.SetCurrentTime((frame + 0.5) / 30.0);
+        channel.SetKeyframe(frame);
+    }
+
+    // Large jumps in both directions, then small steps
+    for (int frame : {2500, 10, 2999, 1, 1500, 1501, 1498, 1490, 3500, 0})
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        ASSERT_NEAR(std::min(frame, 2997), channel.GetAngle(), 0.0001);
+    }
+}
+
+TEST(AnimChannelAngleTest, InsertBefore)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    timeline.SetCurrentTime(1);
+    channel.SetKeyframe(1.0);
+    timeline.SetCurrentTime(2);
+    channel.SetKeyframe(2.0);
+
+    // Insert ahead of the first keyframe, then remove it again
+    timeline.SetCurrentTime(0.5);
+    channel.SetKeyframe(0.5);
+    channel.ClearKeyframe();
+
+    timeline.SetCurrentTime(1.5);
+    ASSERT_TRUE(channel.IsValid());
+    ASSERT_NEAR(1.5, channel.GetAngle(), 0.0001);
+}
+
+TEST(AnimChannelAngleTest, ClearKeyframe)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    for (int i = 1; i <= 3; i++)
+    {
+        timeline.SetCurrentTime(i);
+        channel.SetKeyframe(i * 10.0);
+    }
+
+    // Remove the middle keyframe, so its neighbors tween
+    timeline.SetCurrentTime(2);
+    channel.ClearKeyframe();
+    timeline.SetCurrentTime(2);
+    ASSERT_NEAR(20, channel.GetAngle(), 0.0001);
+
+    timeline.SetCurrentTime(3);
+    ASSERT_NEAR(30, channel.GetAngle(), 0.0001);
+
+    channel.Clear();
+    timeline.SetCurrentTime(1);
+    ASSERT_FALSE(channel.IsValid());
+}
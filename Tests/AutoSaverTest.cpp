@@ -0,0 +1,126 @@
+/**
+ * @file AutoSaverTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+
+#include <AutoSaver.h>
+#include <Picture.h>
+#include <Timeline.h>
+#include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
+
+/**
+ * A picture with some channels on its timeline
+ */
+class AutoSaverPicture
+{
+public:
+    Picture mPicture;               ///< The picture
+    AnimChannelAngle mArm;          ///< An angle channel
+    AnimChannelAngle mLeg;          ///< Another angle channel
+    AnimChannelPoint mPosition;     ///< A point channel
+
+    /// Constructor
+    AutoSaverPicture()
+    {
+        mArm.SetName(L"arm");
+        mLeg.SetName(L"leg");
+        mPosition.SetName(L"position");
+        mPicture.GetTimeline()->AddChannel(&mArm);
+        mPicture.GetTimeline()->AddChannel(&mLeg);
+        mPicture.GetTimeline()->AddChannel(&mPosition);
+    }
+
+    /**
+     * Move the timeline to a frame
+     * @param frame Frame to move to
+     */
+    void SetFrame(int frame)
+    {
+        mPicture.GetTimeline()->SetCurrentTime((frame + 0.5) / mPicture.GetTimeline()->GetFrameRate());
+    }
+};
+
+TEST(AutoSaverTest, SaveAndRecover)
+{
+    auto filename = wxFileName::CreateTempFileName(L"autosave").ToStdWstring();
+
+    AutoSaverPicture edited;
+    {
+        AutoSaver saver(&edited.mPicture, filename);
+
+        edited.SetFrame(10);
+        edited.mArm.SetKeyframe(0.5);
+        edited.mLeg.SetKeyframe(1.5);
+        edited.mPosition.SetKeyframe(wxPoint(3, 4));
+
+        // The first save writes every channel to the autosave file
+        saver.Save();
+        saver.Flush();
+        ASSERT_TRUE(wxFileExists(filename));
+        ASSERT_EQ(0, saver.GetChannelsWritten());
+
+        // Later saves journal only the channels that changed
+        edited.SetFrame(20);
+        edited.mArm.SetKeyframe(0.25);
+        saver.Save();
+        saver.Flush();
+        ASSERT_EQ(1, saver.GetChannelsWritten());
+
+        // With nothing changed, nothing is written
+        saver.Save();
+        saver.Flush();
+        ASSERT_EQ(1, saver.GetChannelsWritten());
+
+        edited.SetFrame(30);
+        edited.mPosition.SetKeyframe(wxPoint(5, 6));
+        edited.mPicture.GetTimeline()->SetNumFrames(450);
+        saver.Save();
+    }
+
+    AutoSaverPicture recovered;
+    ASSERT_TRUE(AutoSaver::Recover(&recovered.mPicture, filename));
+    ASSERT_EQ(450, recovered.mPicture.GetTimeline()->GetNumFrames());
+    ASSERT_EQ(edited.mArm.GetKeyframeFrames(), recovered.mArm.GetKeyframeFrames());
+    ASSERT_EQ(edited.mArm.GetKeyframeAngles(), recovered.mArm.GetKeyframeAngles());
+    ASSERT_EQ(edited.mLeg.GetKeyframeAngles(), recovered.mLeg.GetKeyframeAngles());
+    ASSERT_EQ(edited.mPosition.GetKeyframeFrames(), recovered.mPosition.GetKeyframeFrames());
+    ASSERT_EQ(edited.mPosition.GetKeyframePoints(), recovered.mPosition.GetKeyframePoints());
+
+    AutoSaver::Remove(filename);
+    ASSERT_FALSE(wxFileExists(filename));
+    ASSERT_FALSE(AutoSaver::Recover(&recovered.mPicture, filename));
+}
+
+TEST(AutoSaverTest, Compact)
+{
+    auto filename = wxFileName::CreateTempFileName(L"autosave").ToStdWstring();
+
+    AutoSaverPicture edited;
+    {
+        AutoSaver saver(&edited.mPicture, filename);
+        for (int i = 0; i <= AutoSaver::CompactEntries; i++)
+        {
+            edited.SetFrame(i);
+            edited.mArm.SetKeyframe(i * 0.1);
+            saver.Save();
+        }
+
+        saver.Flush();
+    }
+
+    // The journal has been folded into the autosave file
+    wxFileName journal(AutoSaver::GetJournalFilename(filename));
+    ASSERT_TRUE(journal.GetSize() == 0);
+
+    AutoSaverPicture recovered;
+    ASSERT_TRUE(AutoSaver::Recover(&recovered.mPicture, filename));
+    ASSERT_EQ(edited.mArm.GetKeyframeAngles(), recovered.mArm.GetKeyframeAngles());
+
+    AutoSaver::Remove(filename);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file FrameExporterTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <fstream>
+#include <iterator>
+
+#include <FrameExporter.h>
+#include <Picture.h>
+#include <PictureFactory.h>
+
+TEST(FrameExporterTest, Filename)
+{
+    auto picture = std::make_shared<Picture>();
+    FrameExporter exporter(picture);
+    exporter.SetOutputDir(L"out");
+
+    ASSERT_EQ(wxFileName(L"out", L"frame00042.png").GetFullPath().ToStdWstring(), exporter.GetFrameFilename(42));
+
+    exporter.SetFormat(FrameExporter::Format::RGBA);
+    ASSERT_EQ(wxFileName(L"out", L"frame00007.rgba").GetFullPath().ToStdWstring(), exporter.GetFrameFilename(7));
+
+    // By default the whole animation is rendered
+    ASSERT_EQ(picture->GetTimeline()->GetNumFrames() - 1, exporter.GetLastFrame());
+}
+
+TEST(FrameExporterTest, RenderFrame)
+{
+    auto picture = std::make_shared<Picture>();
+    picture->SetSize(wxSize(64, 32));
+    picture->GetTimeline()->SetFrameRate(30);
+
+    FrameExporter exporter(picture);
+
+    wxImage image;
+    exporter.RenderFrame(15, image);
+
+    ASSERT_EQ(64, image.GetWidth());
+    ASSERT_EQ(32, image.GetHeight());
+    ASSERT_NEAR(0.5, picture->GetAnimationTime(), 0.0001);
+
+    // An empty picture is all background
+    ASSERT_EQ(255, image.GetRed(10, 10));
+    ASSERT_EQ(255, image.GetGreen(10, 10));
+    ASSERT_EQ(255, image.GetBlue(10, 10));
+}
+
+/**
+ * Read an entire file into memory
+ * @param filename File to read
+ * @return File contents
+ */
+static std::string ReadFile(const std::wstring& filename)
+{
+    std::ifstream file(wxString(filename).fn_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST(FrameExporterTest, Parallel)
+{
+    auto createPicture = []() {
+        PictureFactory factory;
+        auto picture = factory.Create(L".");
+        picture->GetTimeline()->SetNumFrames(8);
+        return picture;
+    };
+
+    auto single = wxFileName::CreateTempFileName(L"single");
+    auto parallel = wxFileName::CreateTempFileName(L"parallel");
+    wxRemoveFile(single);
+    wxRemoveFile(parallel);
+    wxFileName::Mkdir(single);
+    wxFileName::Mkdir(parallel);
+
+    FrameExporter exporter1(createPicture());
+    exporter1.SetOutputDir(single.ToStdWstring());
+    exporter1.SetFormat(FrameExporter::Format::RGBA);
+    ASSERT_TRUE(exporter1.Export());
+    ASSERT_EQ(8, exporter1.GetFramesWritten());
+
+    FrameExporter exporter3(createPicture());
+    exporter3.SetOutputDir(parallel.ToStdWstring());
+    exporter3.SetFormat(FrameExporter::Format::RGBA);
+    exporter3.SetThreads(3);
+    exporter3.SetPictureFactory(createPicture);
+    ASSERT_TRUE(exporter3.Export());
+    ASSERT_EQ(8, exporter3.GetFramesWritten());
+
+    // Every frame is byte for byte the same
+    for (int frame = 0; frame < 8; frame++)
+    {
+        auto expected = ReadFile(exporter1.GetFrameFilename(frame));
+        ASSERT_FALSE(expected.empty());
+        ASSERT_EQ(expected, ReadFile(exporter3.GetFrameFilename(frame)));
+    }
+
+    wxFileName::Rmdir(single, wxPATH_RMDIR_RECURSIVE);
+    wxFileName::Rmdir(parallel, wxPATH_RMDIR_RECURSIVE);
+}
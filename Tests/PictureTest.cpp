@@ -6,6 +6,8 @@
 
 #include <pch.h>
 #include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <fstream>
 #include <Picture.h>
 #include <Actor.h>
 
@@ -81,4 +83,29 @@ TEST(PictureTest, GetTimeline)
 
     Timeline *timeline = picture.GetTimeline();
     ASSERT_NE(nullptr, timeline);
-}
\ No newline at end of file
+}
+
+TEST(PictureTest, LoadFailure)
+{
+    Picture picture;
+    auto filename = wxFileName::CreateTempFileName(L"anim");
+
+    {
+        std::ofstream out(filename.fn_str(), std::ios::binary);
+        out << "<?xml version=\"1.0\"?><anim numframes=\"60\" framerate=\"30\"/>";
+    }
+
+    ASSERT_TRUE(picture.Load(filename));
+    ASSERT_EQ(60, picture.GetTimeline()->GetNumFrames());
+
+    // A truncated file is reported
+    {
+        std::ofstream out(filename.fn_str(), std::ios::binary);
+        out << "<?xml version=\"1.0\"?><anim numframes=\"90\" framerate=\"30\"><channel name=\"x\">";
+    }
+
+    ASSERT_FALSE(picture.Load(filename));
+
+    wxRemoveFile(filename);
+    ASSERT_FALSE(picture.Load(filename));
+}
@@ -9,6 +9,7 @@
 
 #include <Timeline.h>
 #include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
 
 
 TEST(TimelineTest, NumFrames)
@@ -84,4 +85,197 @@ TEST(TimelineTest, Add)
 
     timeline.AddChannel(&channel);
     ASSERT_EQ(&timeline, channel.GetTimeline());
-}
\ No newline at end of file
+}
+
+TEST(TimelineTest, Parallel)
+{
+    // Enough channels that evaluation is split between threads
+    const int NumChannels = Timeline::ParallelChannels;
+
+    Timeline timelines[2];
+    std::vector<std::unique_ptr<AnimChannelAngle>> angles[2];
+    std::vector<std::unique_ptr<AnimChannelPoint>> points[2];
+    timelines[0].SetThreads(1);
+    timelines[1].SetThreads(4);
+
+    for (int t = 0; t < 2; t++)
+    {
+        auto& timeline = timelines[t];
+        for (int i = 0; i < NumChannels / 2; i++)
+        {
+            angles[t].push_back(std::make_unique<AnimChannelAngle>());
+            timeline.AddChannel(angles[t].back().get());
+            points[t].push_back(std::make_unique<AnimChannelPoint>());
+            timeline.AddChannel(points[t].back().get());
+        }
+
+        // Keyframes at different frames for each channel
+        for (int i = 0; i < NumChannels / 2; i++)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                timeline.SetCurrentTime((i % 7 + k * 20 + 0.5) / 30.0);
+                angles[t][i]->SetKeyframe(i * 0.001 + k);
+                points[t][i]->SetKeyframe(wxPoint(i, k * 100));
+            }
+        }
+    }
+
+    for (double time : {0.0, 0.5, 1.2, 2.0, 3.5, 1.0})
+    {
+        timelines[0].SetCurrentTime(time);
+        timelines[1].SetCurrentTime(time);
+        for (int i = 0; i < NumChannels / 2; i++)
+        {
+            ASSERT_EQ(angles[0][i]->GetAngle(), angles[1][i]->GetAngle());
+            ASSERT_EQ(points[0][i]->GetPoint(), points[1][i]->GetPoint());
+        }
+    }
+
+    // Spot check one channel against the keyframes
+    timelines[1].SetCurrentTime(3.5);
+    ASSERT_NEAR(3.005, angles[1][5]->GetAngle(), 0.0001);
+    ASSERT_EQ(wxPoint(5, 300), points[1][5]->GetPoint());
+}
+
+TEST(TimelineTest, Bake)
+{
+    Timeline timeline;
+    timeline.SetNumFrames(100);
+    AnimChannelAngle angle;
+    AnimChannelPoint point;
+    timeline.AddChannel(&angle);
+    timeline.AddChannel(&point);
+
+    for (int frame : {10, 25, 70})
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        angle.SetKeyframe(frame * 0.1);
+        point.SetKeyframe(wxPoint(frame, frame * 2));
+    }
+
+    // The tweened values at every frame
+    std::vector<double> angles;
+    std::vector<wxPoint> points;
+    for (int frame = 0; frame <= timeline.GetNumFrames(); frame++)
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        angles.push_back(angle.GetAngle());
+        points.push_back(point.GetPoint());
+    }
+
+    timeline.Bake();
+    ASSERT_TRUE(timeline.IsBaked());
+    ASSERT_TRUE(angle.IsBaked());
+    ASSERT_TRUE(point.IsBaked());
+
+    // Baked values are exactly the tweened ones
+    for (int frame = timeline.GetNumFrames(); frame >= 0; frame--)
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        ASSERT_EQ(angles[frame], angle.GetAngle());
+        ASSERT_EQ(points[frame], point.GetPoint());
+    }
+
+    // Between frames the channels still tween
+    timeline.SetCurrentTime(10.5 / 30.0);
+    ASSERT_NEAR(1.0 + 0.5 * 1.5 / 15, angle.GetAngle(), 0.0001);
+
+    // Editing a channel invalidates only that channel
+    timeline.SetCurrentTime(40 / 30.0);
+    angle.SetKeyframe(10.0);
+    ASSERT_FALSE(angle.IsBaked());
+    ASSERT_TRUE(point.IsBaked());
+
+    timeline.SetCurrentTime(40 / 30.0);
+    ASSERT_NEAR(10.0, angle.GetAngle(), 0.0001);
+
+    timeline.Bake();
+    ASSERT_TRUE(angle.IsBaked());
+    timeline.SetCurrentTime(0);
+    timeline.SetCurrentTime(40 / 30.0);
+    ASSERT_NEAR(10.0, angle.GetAngle(), 0.0001);
+
+    // Clearing a keyframe read from the samples
+    timeline.ClearKeyframe();
+    ASSERT_FALSE(angle.IsBaked());
+    timeline.SetCurrentTime(40 / 30.0);
+    ASSERT_EQ(angles[40], angle.GetAngle());
+
+    timeline.ClearBake();
+    ASSERT_FALSE(timeline.IsBaked());
+    ASSERT_FALSE(point.IsBaked());
+}
+
+TEST(TimelineTest, BakeRange)
+{
+    Timeline timeline;
+    timeline.SetNumFrames(100);
+    AnimChannelAngle angle;
+    timeline.AddChannel(&angle);
+
+    for (int frame : {10, 25, 70})
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        angle.SetKeyframe(frame * 0.1);
+    }
+
+    std::vector<double> angles;
+    for (int frame = 0; frame <= timeline.GetNumFrames(); frame++)
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        angles.push_back(angle.GetAngle());
+    }
+
+    // Frames in the range read the samples, the others tween
+    timeline.Bake(20, 40);
+    ASSERT_TRUE(timeline.IsBaked());
+    ASSERT_TRUE(angle.IsBaked());
+    for (int frame = 0; frame <= timeline.GetNumFrames(); frame++)
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        ASSERT_EQ(angles[frame], angle.GetAngle());
+    }
+
+    // A different range resamples every channel
+    timeline.Bake(60, 200);
+    for (int frame = 0; frame <= timeline.GetNumFrames(); frame++)
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        ASSERT_EQ(angles[frame], angle.GetAngle());
+    }
+}
+
+TEST(TimelineTest, Registry)
+{
+    Timeline timeline;
+    ASSERT_EQ(0, timeline.GetNumChannels());
+
+    AnimChannelAngle angle;
+    angle.SetName(L"Harold:arm");
+    ASSERT_EQ(-1, angle.GetId());
+    timeline.AddChannel(&angle);
+
+    AnimChannelPoint point;
+    point.SetName(L"Harold:position");
+    timeline.AddChannel(&point);
+
+    // A second channel with the same name is not found by it
+    AnimChannelAngle duplicate;
+    duplicate.SetName(L"Harold:arm");
+    timeline.AddChannel(&duplicate);
+
+    ASSERT_EQ(3, timeline.GetNumChannels());
+    ASSERT_EQ(0, angle.GetId());
+    ASSERT_EQ(1, point.GetId());
+    ASSERT_EQ(2, duplicate.GetId());
+
+    ASSERT_EQ(angle.GetId(), timeline.FindChannel(L"Harold:arm"));
+    ASSERT_EQ(point.GetId(), timeline.FindChannel(L"Harold:position"));
+    ASSERT_EQ(Timeline::NoChannel, timeline.FindChannel(L"Harold:leg"));
+
+    for (int id = 0; id < timeline.GetNumChannels(); id++)
+    {
+        ASSERT_EQ(id, timeline.GetChannel(id)->GetId());
+    }
+}
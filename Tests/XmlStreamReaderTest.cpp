@@ -0,0 +1,107 @@
+/**
+ * @file XmlStreamReaderTest.cpp
+ *
+ * @author Aditya Menon
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <XmlStreamReader.h>
+#include <Timeline.h>
+#include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
+
+/**
+ * Parse XML and record the tags in the order they are read
+ * @param xml XML to parse
+ * @param tags Receives "<name" for each start and "/name" for each end
+ * @return Result of the parse
+ */
+static bool Parse(const std::string& xml, std::vector<std::string>& tags)
+{
+    XmlStreamReader reader;
+    reader.SetStartHandler([&tags](const XmlStreamElement& element) {
+        tags.push_back("<" + std::string(element.GetName()));
+    });
+    reader.SetEndHandler([&tags](std::string_view name) {
+        tags.push_back("/" + std::string(name));
+    });
+
+    return reader.Parse(xml.data(), xml.size());
+}
+
+TEST(XmlStreamReaderTest, Tags)
+{
+    std::vector<std::string> tags;
+    ASSERT_TRUE(Parse("<?xml version=\"1.0\"?>\n<!-- <skipped/> -->\n"
+                      "<anim a=\"1\">text<channel/>\n<b><c x='2' /></b></anim>\n", tags));
+    ASSERT_EQ(std::vector<std::string>({"<anim", "<channel", "/channel", "<b", "<c", "/c", "/b", "/anim"}), tags);
+
+    // Badly formed XML is an error
+    tags.clear();
+    ASSERT_FALSE(Parse("<anim><channel></anim>", tags));
+    ASSERT_FALSE(Parse("<anim x=1/>", tags));
+    ASSERT_FALSE(Parse("<anim>", tags));
+}
+
+TEST(XmlStreamReaderTest, Attributes)
+{
+    XmlStreamReader reader;
+    int elements = 0;
+    reader.SetStartHandler([&elements](const XmlStreamElement& element) {
+        elements++;
+        ASSERT_EQ("a < b & \"c\" \xC3\xA9", element.GetAttribute("name"));
+        ASSERT_EQ(-42, element.GetAttributeInt("frame"));
+        ASSERT_EQ(0.125, element.GetAttributeDouble("angle"));
+        ASSERT_EQ(7, element.GetAttributeInt("missing", 7));
+        ASSERT_TRUE(element.HasAttribute("angle"));
+        ASSERT_FALSE(element.HasAttribute("missing"));
+    });
+
+    std::string xml = "<keyframe name=\"a &lt; b &amp; &quot;c&quot; &#xE9;\" frame=\"-42\" angle = '0.125'/>";
+    ASSERT_TRUE(reader.Parse(xml.data(), xml.size()));
+    ASSERT_EQ(1, elements);
+}
+
+TEST(XmlStreamReaderTest, Timeline)
+{
+    Timeline timeline;
+
+    AnimChannelAngle angle;
+    angle.SetName(L"arm");
+    timeline.AddChannel(&angle);
+
+    AnimChannelPoint point;
+    point.SetName(L"position");
+    timeline.AddChannel(&point);
+
+    XmlStreamReader reader;
+    reader.SetStartHandler([&timeline](const XmlStreamElement& element) { timeline.XmlStreamStart(element); });
+    reader.SetEndHandler([&timeline](std::string_view name) { timeline.XmlStreamEnd(name); });
+
+    // Keyframes out of order and repeated load the same as
+    // setting them in that order would
+    std::string xml = "<anim numframes=\"200\" framerate=\"20\">"
+                      "<channel name=\"arm\"><keyframe frame=\"40\" angle=\"2.5\"/>"
+                      "<keyframe frame=\"10\" angle=\"1\"/><keyframe frame=\"40\" angle=\"2\"/></channel>"
+                      "<channel name=\"unknown\"><keyframe frame=\"5\" angle=\"9\"/></channel>"
+                      "<channel name=\"position\"><keyframe frame=\"0\" x=\"10\" y=\"-20\"/></channel>"
+                      "</anim>";
+    ASSERT_TRUE(reader.Parse(xml.data(), xml.size()));
+
+    ASSERT_EQ(200, timeline.GetNumFrames());
+    ASSERT_EQ(20, timeline.GetFrameRate());
+    ASSERT_EQ(std::vector<int>({10, 40}), angle.GetKeyframeFrames());
+    ASSERT_EQ(std::vector<double>({1, 2}), angle.GetKeyframeAngles());
+    ASSERT_EQ(std::vector<int>({0}), point.GetKeyframeFrames());
+
+    timeline.SetCurrentTime(25 / 20.0);
+    ASSERT_NEAR(1.5, angle.GetAngle(), 0.0001);
+    ASSERT_EQ(wxPoint(10, -20), point.GetPoint());
+
+    // And the loaded channel can be edited
+    timeline.SetCurrentTime(30.5 / 20.0);
+    angle.SetKeyframe(0);
+    ASSERT_EQ(std::vector<int>({10, 30, 40}), angle.GetKeyframeFrames());
+}
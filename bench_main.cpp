@@ -0,0 +1,51 @@
+/**
+ * @file bench_main.cpp
+ * @author Aditya Menon
+ *
+ * Main entry point shared by the benchmark programs
+ *
+ * Unless the command line names its own --benchmark_out, the results
+ * are also written as JSON to BENCH_NAME.json in the working directory.
+ */
+
+#include <benchmark/benchmark.h>
+#include <wx/image.h>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    // Results go to a JSON file unless the command line says otherwise,
+    // so runs from different commits can be compared with compare.py
+    std::vector<char*> args(argv, argv + argc);
+    std::string out = "--benchmark_out=" + std::string(BENCH_NAME) + ".json";
+    std::string format = "--benchmark_out_format=json";
+
+    bool hasOut = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]).rfind("--benchmark_out=", 0) == 0)
+        {
+            hasOut = true;
+        }
+    }
+
+    if (!hasOut)
+    {
+        args.push_back(out.data());
+        args.push_back(format.data());
+    }
+
+    int count = int(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+    {
+        return 1;
+    }
+
+    wxInitAllImageHandlers();
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
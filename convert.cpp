@@ -0,0 +1,10 @@
+/**
+ * @file convert.cpp
+ * @author Aditya Menon
+ *
+ * Main entry point for the animation file converter
+ */
+#include "pch.h"
+#include "ConvertApp.h"
+
+wxIMPLEMENT_APP_CONSOLE(ConvertApp);
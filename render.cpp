@@ -0,0 +1,10 @@
+/**
+ * @file render.cpp
+ * @author Aditya Menon
+ *
+ * Main entry point for the command-line renderer
+ */
+#include "pch.h"
+#include "RenderApp.h"
+
+wxIMPLEMENT_APP_CONSOLE(RenderApp);